@@ -0,0 +1,335 @@
+#pragma once
+
+/// <summary>
+///        .
+/// </summary>
+enum ACCESS_PATTERN : int
+{
+	SEQUENTIAL, REVERSE, RANDOM, STRIDED, NEIGHBORHOOD, SCAN, CONSTRUCTION, DESTRUCTION, NAIVE_CONVERSION, BLOCKED_CONVERSION, PARALLEL_CONVERSION, MEMORY_COPY, KERNEL_SCALE
+};
+
+/// <summary>
+///    .
+/// </summary>
+struct benchmark_result
+{
+	/// <summary>
+	///   .
+	/// </summary>
+	const char* layout;
+
+	/// <summary>
+	///    .
+	/// </summary>
+	const char* type;
+
+	/// <summary>
+	///    .
+	/// </summary>
+	ACCESS_PATTERN pattern;
+
+	/// <summary>
+	///     .
+	/// </summary>
+	size_t bytes;
+
+	/// <summary>
+	///    .
+	/// </summary>
+	size_t length;
+
+	/// <summary>
+	///      ,    .
+	/// </summary>
+	double nanoseconds;
+};
+
+/// <summary>
+///      ,   .
+/// </summary>
+/// <param name='pattern'>   .</param>
+/// <returns>    .</returns>
+inline const char* getPatternName(ACCESS_PATTERN pattern)
+{
+	static const char* names[] = { "sequential", "reverse", "random", "strided", "neighborhood", "scan", "construction", "destruction",
+		"naive-conversion", "blocked-conversion", "parallel-conversion", "memcpy", "kernel-scale" };
+	return names[pattern];
+}
+
+/// <summary>
+///       ,      .
+/// </summary>
+/// <param name='length'>   .</param>
+/// <param name='index'>    ;       ASDC.Lab4.</param>
+inline void getShape(size_t length, int (&index)[4][2])
+{
+	static const int lower[4] = { 1, 0, -3, 4 };
+	size_t side = 1;
+	while ((side + 1) * (side + 1) * (side + 1) * (side + 1) <= length)
+		side++;
+	size_t last = length / (side * side * side);
+	for (int i = 0; i < 4; i++)
+	{
+		index[i][0] = lower[i];
+		index[i][1] = lower[i] + (int)(i == 3 ? last : side) - 1;
+	}
+}
+
+/// <summary>
+///   ,     ,     .
+/// </summary>
+inline int64_t getValue(int item)
+{
+	return item;
+}
+
+inline int64_t getValue(double item)
+{
+	return (int64_t)item;
+}
+
+inline int64_t getValue(const CITIZEN& item)
+{
+	return item.pin;
+}
+
+/// <summary>
+///   ,     .
+/// </summary>
+inline void setValue(int& item, int64_t value)
+{
+	item = (int)value;
+}
+
+inline void setValue(double& item, int64_t value)
+{
+	item = (double)value;
+}
+
+inline void setValue(CITIZEN& item, int64_t value)
+{
+	item.pin = value;
+}
+
+/// <summary>
+///  ,     .
+/// </summary>
+extern volatile int64_t benchmarkSink;
+
+/// <summary>
+///    .
+/// </summary>
+/// <param name='function'> .</param>
+/// <returns>   .</returns>
+template<typename Function>
+inline double measure(Function function)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	function();
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+template<typename T, template<typename> class Layout>
+/// <summary>
+///           <see cref="matrix4::at"/>.
+/// </summary>
+/// <remarks>
+/// <see cref="NEIGHBORHOOD"/>         ,      ;
+/// <see cref="SCAN"/>       <see cref="matrix4::forEach"/>.
+/// </remarks>
+/// <param name='matrix'> .</param>
+/// <param name='pattern'> :  <see cref="SEQUENTIAL"/>  <see cref="SCAN"/>.</param>
+/// <returns>    .</returns>
+int64_t traverse(matrix4<T, Layout>& matrix, ACCESS_PATTERN pattern)
+{
+	int l1 = matrix.getLowerBound(1), h1 = matrix.getUpperBound(1);
+	int l2 = matrix.getLowerBound(2), h2 = matrix.getUpperBound(2);
+	int l3 = matrix.getLowerBound(3), h3 = matrix.getUpperBound(3);
+	int l4 = matrix.getLowerBound(4), h4 = matrix.getUpperBound(4);
+	int64_t sum = 0;
+	switch (pattern)
+	{
+	case SEQUENTIAL:
+		for (int i1 = l1; i1 <= h1; i1++)
+			for (int i2 = l2; i2 <= h2; i2++)
+				for (int i3 = l3; i3 <= h3; i3++)
+					for (int i4 = l4; i4 <= h4; i4++)
+						sum += getValue(matrix.at(i1, i2, i3, i4));
+		break;
+	case REVERSE:
+		for (int i1 = h1; i1 >= l1; i1--)
+			for (int i2 = h2; i2 >= l2; i2--)
+				for (int i3 = h3; i3 >= l3; i3--)
+					for (int i4 = h4; i4 >= l4; i4--)
+						sum += getValue(matrix.at(i1, i2, i3, i4));
+		break;
+	case STRIDED:
+		for (int i4 = l4; i4 <= h4; i4++)
+			for (int i3 = l3; i3 <= h3; i3++)
+				for (int i2 = l2; i2 <= h2; i2++)
+					for (int i1 = l1; i1 <= h1; i1++)
+						sum += getValue(matrix.at(i1, i2, i3, i4));
+		break;
+	case NEIGHBORHOOD:
+		for (int i1 = l1 + 1; i1 < h1; i1++)
+			for (int i2 = l2 + 1; i2 < h2; i2++)
+				for (int i3 = l3 + 1; i3 < h3; i3++)
+					for (int i4 = l4 + 1; i4 < h4; i4++)
+						sum += getValue(matrix.at(i1, i2, i3, i4))
+							+ getValue(matrix.at(i1 - 1, i2, i3, i4)) + getValue(matrix.at(i1 + 1, i2, i3, i4))
+							+ getValue(matrix.at(i1, i2 - 1, i3, i4)) + getValue(matrix.at(i1, i2 + 1, i3, i4))
+							+ getValue(matrix.at(i1, i2, i3 - 1, i4)) + getValue(matrix.at(i1, i2, i3 + 1, i4))
+							+ getValue(matrix.at(i1, i2, i3, i4 - 1)) + getValue(matrix.at(i1, i2, i3, i4 + 1));
+		break;
+	case SCAN:
+		matrix.forEach([&sum](T& item, int, int, int, int) { sum += getValue(item); });
+		break;
+	case RANDOM:
+	{
+		uint64_t n1 = h1 - l1 + 1, n2 = h2 - l2 + 1, n3 = h3 - l3 + 1, n4 = h4 - l4 + 1;
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		for (size_t i = matrix.getLength(); i > 0; i--)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			uint64_t r1 = (uint32_t)state, r2 = (uint32_t)(state >> 32);
+			sum += getValue(matrix.at(
+				l1 + (int)(((r1 & 0xFFFF) * n1) >> 16),
+				l2 + (int)(((r1 >> 16) * n2) >> 16),
+				l3 + (int)(((r2 & 0xFFFF) * n3) >> 16),
+				l4 + (int)(((r2 >> 16) * n4) >> 16)));
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return sum;
+}
+
+template<typename T, template<typename> class Layout, template<typename> class SourceLayout>
+/// <summary>
+///      <typeparamref name="SourceLayout"/>       :
+///   <see cref="matrix4::at"/>    ,   <see cref="matrix4_parallel::copy"/>
+///       ,         <c>memcpy</c>    
+///       <see cref="matrix4_kernels::scale"/>,       .
+/// </summary>
+/// <remarks>
+///  <see cref="zmatrix4"/>  <see cref="bmatrix4"/>       ,  <see cref="matrix4_parallel::copy"/>   .
+///      ,   ,     <see cref="KERNEL_SCALE"/>  .
+/// </remarks>
+/// <param name='matrix'> .</param>
+/// <param name='best'>     ,    <see cref="ACCESS_PATTERN"/>.</param>
+/// <exception cref="std::bad_alloc">     -.</exception>
+void convert(matrix4<T, Layout>& matrix, double (&best)[13])
+{
+	int l1 = matrix.getLowerBound(1), h1 = matrix.getUpperBound(1);
+	int l2 = matrix.getLowerBound(2), h2 = matrix.getUpperBound(2);
+	int l3 = matrix.getLowerBound(3), h3 = matrix.getUpperBound(3);
+	int l4 = matrix.getLowerBound(4), h4 = matrix.getUpperBound(4);
+	matrix4<T, SourceLayout> source(l1, h1, l2, h2, l3, h3, l4, h4);
+	int64_t value = 0;
+	source.forEach([&](T& item, int, int, int, int) { setValue(item, value++); });
+
+	double time = measure([&]()
+	{
+		if (Layout<T>::order == ROW_MAJOR)
+		{
+			for (int i1 = l1; i1 <= h1; i1++)
+				for (int i2 = l2; i2 <= h2; i2++)
+					for (int i3 = l3; i3 <= h3; i3++)
+						for (int i4 = l4; i4 <= h4; i4++)
+							matrix.at(i1, i2, i3, i4) = source.at(i1, i2, i3, i4);
+		}
+		else
+		{
+			for (int i4 = l4; i4 <= h4; i4++)
+				for (int i3 = l3; i3 <= h3; i3++)
+					for (int i2 = l2; i2 <= h2; i2++)
+						for (int i1 = l1; i1 <= h1; i1++)
+							matrix.at(i1, i2, i3, i4) = source.at(i1, i2, i3, i4);
+		}
+	});
+	best[NAIVE_CONVERSION] = time < best[NAIVE_CONVERSION] ? time : best[NAIVE_CONVERSION];
+	time = measure([&]() { matrix4_parallel::copy(matrix, source, 1); });
+	best[BLOCKED_CONVERSION] = time < best[BLOCKED_CONVERSION] ? time : best[BLOCKED_CONVERSION];
+	time = measure([&]() { matrix4_parallel::copy(matrix, source); });
+	best[PARALLEL_CONVERSION] = time < best[PARALLEL_CONVERSION] ? time : best[PARALLEL_CONVERSION];
+	time = measure([&]() { memcpy(&matrix(l1, l2, l3, l4), &source(l1, l2, l3, l4), matrix.getLength() * sizeof(T)); });
+	best[MEMORY_COPY] = time < best[MEMORY_COPY] ? time : best[MEMORY_COPY];
+	if constexpr (std::is_arithmetic<T>::value && hasLines(Layout<T>::order))
+	{
+		time = measure([&]() { matrix4_kernels::scale(matrix, (T)1, matrix); });
+		best[KERNEL_SCALE] = time < best[KERNEL_SCALE] ? time : best[KERNEL_SCALE];
+	}
+	benchmarkSink = getValue(matrix(h1, h2, h3, h4));
+}
+
+template<typename T, template<typename> class Layout>
+/// <summary>
+///  , ,       <typeparamref name="Layout"/>      
+///       (<see cref="icmatrix4_layout"/>  <see cref="ilmatrix4_layout"/>).
+/// </summary>
+/// <param name='layout'>   .</param>
+/// <param name='type'>    .</param>
+/// <param name='bytes'>     .</param>
+/// <param name='repeat'>   ;     .</param>
+/// <param name='results'>,    ;     .</param>
+/// <returns>false,         .</returns>
+bool runBenchmark(const char* layout, const char* type, size_t bytes, int repeat, std::vector<benchmark_result>& results)
+{
+	int index[4][2];
+	getShape(bytes / sizeof(T) > 0 ? bytes / sizeof(T) : 1, index);
+	double best[13];
+	for (int i = 0; i < 13; i++)
+		best[i] = (std::numeric_limits<double>::max)();
+	size_t length = 0;
+
+	try
+	{
+		for (int r = 0; r < repeat; r++)
+		{
+			matrix4<T, Layout>* matrix = nullptr;
+			double time = measure([&]() { matrix = new matrix4<T, Layout>(index[0][0], index[0][1], index[1][0], index[1][1], index[2][0], index[2][1], index[3][0], index[3][1]); });
+			best[CONSTRUCTION] = time < best[CONSTRUCTION] ? time : best[CONSTRUCTION];
+			length = matrix->getLength();
+
+			int64_t value = 0;
+			matrix->forEach([&](T& item, int, int, int, int) { setValue(item, value++); });
+			for (int pattern = SEQUENTIAL; pattern <= SCAN; pattern++)
+			{
+				int64_t sum = 0;
+				time = measure([&]() { sum = traverse(*matrix, (ACCESS_PATTERN)pattern); });
+				benchmarkSink = sum;
+				best[pattern] = time < best[pattern] ? time : best[pattern];
+			}
+
+			try
+			{
+				if (Layout<T>::order == ROW_MAJOR)
+					convert<T, Layout, icmatrix4_layout>(*matrix, best);
+				else
+					convert<T, Layout, ilmatrix4_layout>(*matrix, best);
+			}
+			catch (std::bad_alloc&)
+			{
+				delete matrix;
+				throw;
+			}
+
+			time = measure([&]() { delete matrix; });
+			best[DESTRUCTION] = time < best[DESTRUCTION] ? time : best[DESTRUCTION];
+		}
+	}
+	catch (std::bad_alloc&)
+	{
+		return false;
+	}
+
+	for (int pattern = SEQUENTIAL; pattern <= KERNEL_SCALE; pattern++)
+		if (best[pattern] < (std::numeric_limits<double>::max)())
+			results.push_back({ layout, type, (ACCESS_PATTERN)pattern, length * sizeof(T), length, best[pattern] / length });
+	return true;
+}
@@ -0,0 +1,135 @@
+#include "stdafx.h"
+
+
+/// <summary>
+///      ,     .
+/// </summary>
+#define FILE_TEST_FILE "ASDC.Lab4.Tests.file.bin"
+
+/// <summary>
+/// ,       .
+/// </summary>
+static bool IsSame(const citizen_view& a, const citizen_view& b)
+{
+	return a.pin == b.pin && a.first_name == b.first_name && a.last_name == b.last_name &&
+		a.day == b.day && a.month == b.month && a.year == b.year && a.gender == b.gender;
+}
+
+/// <summary>
+///    <paramref name="length"/>   <see cref="citizen_file::read"/>  <see cref="citizen_file::readParallel"/>      .
+/// </summary>
+static void TestRead(const char* name, const citizen_file& file, size_t length, unsigned threadCount)
+{
+	std::vector<citizen_view> expected(length), actual(length);
+	size_t count = file.read(expected.data(), length);
+	size_t parallel = file.readParallel(actual.data(), length, threadCount);
+	int mismatches = 0;
+	for (size_t i = 0; i < count && i < parallel; i++)
+		if (!IsSame(expected[i], actual[i]))
+			mismatches++;
+	check(parallel == count && mismatches == 0, "readParallel %s, %zu of %d records, %u threads: %zu records instead of %zu, %d differ",
+		name, length, file.getCount(), threadCount, parallel, count, mismatches);
+}
+
+/// <summary>
+/// ,  <see cref="citizen_file::read"/>  <see cref="citizen_file::readParallel"/>  <c>std::runtime_error</c>,    .
+/// </summary>
+/// <remarks>     ,         .</remarks>
+static void TestTruncated(const citizen_file& file, unsigned threadCount)
+{
+	std::vector<citizen_view> items(file.getCount());
+	int thrown = 0;
+	try { file.read(items.data(), items.size()); } catch (const std::runtime_error&) { thrown++; }
+	try { file.readParallel(items.data(), items.size(), threadCount); } catch (const std::runtime_error&) { thrown++; }
+	check(thrown == 2, "readParallel truncated, %u threads: %d of 2 reads threw std::runtime_error", threadCount, thrown);
+}
+
+/// <summary>
+///       .
+/// </summary>
+/// <returns> true,    .</returns>
+static bool Truncate(const char* path, size_t bytes)
+{
+	std::vector<char> data;
+	FILE* file = fopen(path, "rb");
+	if (file != nullptr)
+	{
+		char buffer[4096];
+		size_t read;
+		while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+			data.insert(data.end(), buffer, buffer + read);
+		fclose(file);
+	}
+	file = fopen(path, "wb");
+	if (!check(file != nullptr && data.size() >= bytes, "cannot truncate %s", path))
+	{
+		if (file != nullptr)
+			fclose(file);
+		return false;
+	}
+	fwrite(data.data(), 1, data.size() - bytes, file);
+	fclose(file);
+	return true;
+}
+
+void testFile()
+{
+	unsigned hardware = std::thread::hardware_concurrency();
+	temporary_file path = { FILE_TEST_FILE };
+
+	//      ,     
+	int count = 1001;
+	if (!writeCitizens(path.path, count))
+		return;
+	{
+		citizen_file file(path.path);
+		const unsigned threadCounts[] = { 1, 2, 3, hardware, 0 };
+		for (unsigned threadCount : threadCounts)
+		{
+			TestRead("all", file, (size_t)count, threadCount);
+			TestRead("prefix", file, 10, threadCount);
+			TestRead("longer array", file, (size_t)count + 5, threadCount);
+		}
+		TestRead("none", file, 0, 4);
+	}
+
+	//  ,  
+	if (!writeCitizens(path.path, 5))
+		return;
+	{
+		citizen_file file(path.path);
+		TestRead("few", file, 5, 16);
+		TestRead("few", file, 5, 5);
+	}
+
+	//       
+	if (!writeCitizens(path.path, 0))
+		return;
+	{
+		citizen_file file(path.path);
+		const unsigned threadCounts[] = { 1, 2, hardware };
+		for (unsigned threadCount : threadCounts)
+			TestRead("empty", file, 0, threadCount);
+		TestRead("empty", file, 8, 4);
+	}
+	if (!Truncate(path.path, sizeof(int)))
+		return;
+	bool thrown = false;
+	try { citizen_file file(path.path); } catch (const std::runtime_error&) { thrown = true; }
+	check(thrown, "citizen_file: a file without a header did not throw std::runtime_error");
+
+	//      ,      ;  ,  , - 
+	const int truncatedCounts[] = { count, 5 };
+	for (int records : truncatedCounts)
+	{
+		if (!writeCitizens(path.path, records) || !Truncate(path.path, 4 * sizeof(int) + 1))
+			return;
+		citizen_file file(path.path);
+		const unsigned threadCounts[] = { 1, 2, hardware, 16 };
+		for (unsigned threadCount : threadCounts)
+		{
+			TestTruncated(file, threadCount);
+			TestRead("before truncation", file, (size_t)records - 1, threadCount);
+		}
+	}
+}
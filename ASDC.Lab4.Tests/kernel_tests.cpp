@@ -0,0 +1,193 @@
+#include "stdafx.h"
+
+
+/// <summary>
+///     <see cref="KERNEL_ISA"/>   .
+/// </summary>
+static const char* const IsaNames[] = { "scalar", "sse4.2", "avx2", "avx512" };
+
+/// <summary>
+///    ,    ,     .
+/// </summary>
+struct isa_selection
+{
+	KERNEL_ISA isa;
+
+	~isa_selection()
+	{
+		kernel_dispatch::setIsa(isa);
+	}
+};
+
+/// <summary>
+///     :          <c>float</c>,      .
+/// </summary>
+static int GetSmallValue(int i1, int i2, int i3, int i4, int seed)
+{
+	return ((i1 * 7 + i2 * 13 + i3 * 5 + i4 * 3 + seed) % 61 + 61) % 61 - 30;
+}
+
+/// <summary>
+///       <see cref="matrix4::at"/>  <see cref="GetSmallValue"/>  .
+/// </summary>
+template<typename T, template<typename> class Layout>
+static void FillSmallValues(matrix4<T, Layout>& matrix, const test_bounds& bounds, int seed)
+{
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		matrix.at(i1, i2, i3, i4) = (T)GetSmallValue(i1, i2, i3, i4, seed);
+	});
+}
+
+/// <summary>
+///    ,       <c>expected(int i1, int i2, int i3, int i4)</c>.
+/// </summary>
+template<typename T, template<typename> class Layout, typename Expected>
+static int CountMismatches(matrix4<T, Layout>& matrix, const test_bounds& bounds, Expected expected)
+{
+	int mismatches = 0;
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		if (matrix.at(i1, i2, i3, i4) != expected(i1, i2, i3, i4))
+			mismatches++;
+	});
+	return mismatches;
+}
+
+/// <summary>
+///      .
+/// </summary>
+template<typename T>
+static T Apply(BINARY_OPERATION operation, T x, T y)
+{
+	switch (operation)
+	{
+	case BINARY_ADD:
+		return x + y;
+	case BINARY_SUBTRACT:
+		return x - y;
+	case BINARY_MULTIPLY:
+		return x * y;
+	case BINARY_MINIMUM:
+		return y < x ? y : x;
+	default:
+		return x < y ? y : x;
+	}
+}
+
+/// <summary>
+///      .
+/// </summary>
+template<typename T>
+static T Apply(UNARY_OPERATION operation, T x)
+{
+	switch (operation)
+	{
+	case UNARY_NEGATE:
+		return -x;
+	case UNARY_ABSOLUTE:
+		return x < 0 ? -x : x;
+	default:
+		return x * x;
+	}
+}
+
+/// <summary>
+///    <see cref="matrix4_kernels"/>     <typeparamref name="Layout"/>    <typeparamref name="LayoutA"/>
+///    <see cref="matrix4::at"/>     .
+/// </summary>
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+static void TestKernels(const char* type, const char* name, const test_bounds& bounds)
+{
+	const char* isa = IsaNames[kernel_dispatch::getIsa()];
+	matrix4<T, LayoutA> a(bounds, DEFAULT_INITIALIZATION);
+	matrix4<T, Layout> b(bounds, DEFAULT_INITIALIZATION);
+	matrix4<T, Layout> result(bounds, DEFAULT_INITIALIZATION);
+	FillSmallValues(a, bounds, 0);
+	FillSmallValues(b, bounds, 17);
+
+	const BINARY_OPERATION binaries[] = { BINARY_ADD, BINARY_SUBTRACT, BINARY_MULTIPLY, BINARY_MINIMUM, BINARY_MAXIMUM };
+	for (BINARY_OPERATION operation : binaries)
+	{
+		matrix4_kernels::transform(result, operation, a, b);
+		int mismatches = CountMismatches(result, bounds, [&](int i1, int i2, int i3, int i4) { return Apply(operation, a.at(i1, i2, i3, i4), b.at(i1, i2, i3, i4)); });
+		check(mismatches == 0, "transform %s %s, %s, binary operation %d: %d elements differ", type, name, isa, (int)operation, mismatches);
+	}
+
+	const UNARY_OPERATION unaries[] = { UNARY_NEGATE, UNARY_ABSOLUTE, UNARY_SQUARE };
+	for (UNARY_OPERATION operation : unaries)
+	{
+		matrix4_kernels::transform(result, operation, a);
+		int mismatches = CountMismatches(result, bounds, [&](int i1, int i2, int i3, int i4) { return Apply(operation, a.at(i1, i2, i3, i4)); });
+		check(mismatches == 0, "transform %s %s, %s, unary operation %d: %d elements differ", type, name, isa, (int)operation, mismatches);
+	}
+
+	matrix4_kernels::scale(result, (T)3, a);
+	int mismatches = CountMismatches(result, bounds, [&](int i1, int i2, int i3, int i4) { return (T)3 * a.at(i1, i2, i3, i4); });
+	check(mismatches == 0, "scale %s %s, %s: %d elements differ", type, name, isa, mismatches);
+
+	FillSmallValues(result, bounds, 17);
+	matrix4_kernels::axpy((T)-2, a, result);
+	mismatches = CountMismatches(result, bounds, [&](int i1, int i2, int i3, int i4) { return (T)-2 * a.at(i1, i2, i3, i4) + b.at(i1, i2, i3, i4); });
+	check(mismatches == 0, "axpy %s %s, %s: %d elements differ", type, name, isa, mismatches);
+
+	T sumA = 0, sumB = 0, dot = 0, minimum = a.at(bounds[0][0], bounds[1][0], bounds[2][0], bounds[3][0]), maximum = minimum;
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		T item = a.at(i1, i2, i3, i4);
+		sumA += item;
+		sumB += b.at(i1, i2, i3, i4);
+		dot += item * b.at(i1, i2, i3, i4);
+		minimum = item < minimum ? item : minimum;
+		maximum = maximum < item ? item : maximum;
+	});
+	check(matrix4_kernels::sum(a) == sumA && matrix4_kernels::sum(b) == sumB, "sum %s %s, %s: differs from the sum over at()", type, name, isa);
+	check(matrix4_kernels::minimum(a) == minimum, "minimum %s %s, %s: differs from the minimum over at()", type, name, isa);
+	check(matrix4_kernels::maximum(a) == maximum, "maximum %s %s, %s: differs from the maximum over at()", type, name, isa);
+	check(matrix4_kernels::dot(a, b) == dot && matrix4_kernels::dot(b, a) == dot, "dot %s %s, %s: differs from the sum over at()", type, name, isa);
+
+	//        ,       
+	T& last = a.at(bounds[0][1], bounds[1][1], bounds[2][1], bounds[3][1]);
+	last = (T)100;
+	check(matrix4_kernels::maximum(a) == (T)100, "maximum %s %s, %s: the last element is missed", type, name, isa);
+	last = (T)-100;
+	check(matrix4_kernels::minimum(a) == (T)-100, "minimum %s %s, %s: the last element is missed", type, name, isa);
+}
+
+/// <summary>
+///  <see cref="TestKernels"/>     ,         .
+/// </summary>
+template<typename T>
+static void TestKernels(const char* type, const test_bounds& bounds)
+{
+	TestKernels<T, lmatrix4_layout, lmatrix4_layout>(type, "lmatrix4 x lmatrix4", bounds);
+	TestKernels<T, cmatrix4_layout, cmatrix4_layout>(type, "cmatrix4 x cmatrix4", bounds);
+	TestKernels<T, cmatrix4m_layout64, cmatrix4m_layout64>(type, "cmatrix4m64 x cmatrix4m64", bounds);
+	TestKernels<T, cmatrix4m_layout64, cmatrix4_layout>(type, "cmatrix4m64 x cmatrix4", bounds);
+	TestKernels<T, lmatrix4_layout, cmatrix4_layout>(type, "lmatrix4 x cmatrix4", bounds);
+	TestKernels<T, lmatrix4m_layout64, cmatrix4m_layout64>(type, "lmatrix4m64 x cmatrix4m64", bounds);
+}
+
+void testKernels()
+{
+	//   (19  3)    (285)      ;      AVX2  float,    
+	test_bounds tail = { { { -1, 1 }, { 4, 4 }, { 2, 6 }, { 0, 18 } } };
+	test_bounds few = { { { 0, 2 }, { 0, 0 }, { 0, 0 }, { 5, 6 } } };
+	test_bounds single = { { { 3, 3 }, { 0, 0 }, { -1, -1 }, { 0, 0 } } };
+
+	isa_selection selection = { kernel_dispatch::getIsa() };
+	for (int isa = ISA_SCALAR; isa <= ISA_AVX512; isa++)
+	{
+		//     ,   
+		kernel_dispatch::setIsa((KERNEL_ISA)isa);
+		if (kernel_dispatch::getIsa() != isa)
+			continue;
+		for (const test_bounds* bounds : { &tail, &few, &single })
+		{
+			TestKernels<float>("float", *bounds);
+			TestKernels<double>("double", *bounds);
+			TestKernels<int32_t>("int32_t", *bounds);
+			TestKernels<int64_t>("int64_t", *bounds);
+		}
+	}
+}
@@ -0,0 +1,135 @@
+#include "stdafx.h"
+
+
+/// <summary>
+///    ,     <see cref="getTestValue"/>      <see cref="matrix4::at"/>.
+/// </summary>
+template<typename T, template<typename> class Layout>
+static int CountMismatches(matrix4<T, Layout>& matrix, const test_bounds& bounds)
+{
+	int mismatches = 0;
+	for (int d = 0; d < 4; d++)
+		if (matrix.getLowerBound(d + 1) != bounds[d][0] || matrix.getUpperBound(d + 1) != bounds[d][1])
+			return -1;
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		if (matrix.at(i1, i2, i3, i4) != (T)getTestValue(i1, i2, i3, i4))
+			mismatches++;
+	});
+	return mismatches;
+}
+
+/// <summary>
+///          <see cref="matrix4_parallel::convert"/>      <see cref="matrix4::at"/>.
+/// </summary>
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+static void TestConvert(const char* name, const char* nameA, const test_bounds& bounds, unsigned threadCount)
+{
+	matrix4<T, LayoutA> source(bounds, DEFAULT_INITIALIZATION);
+	fillTestValues(source, bounds);
+	matrix4<T, Layout> result = matrix4_parallel::convert<Layout>(source, threadCount);
+	int mismatches = CountMismatches(result, bounds);
+	check(mismatches == 0, "convert %s -> %s: %d elements differ", nameA, name, mismatches);
+	matrix4<T, LayoutA> back = matrix4_parallel::convert<LayoutA>(result, threadCount);
+	mismatches = CountMismatches(back, bounds);
+	check(mismatches == 0, "convert %s -> %s -> %s: %d elements differ", nameA, name, nameA, mismatches);
+}
+
+/// <summary>
+///  <see cref="TestConvert"/>       .
+/// </summary>
+template<typename T, template<typename> class LayoutA>
+static void TestConvertFrom(const char* nameA, const test_bounds& bounds, unsigned threadCount)
+{
+	TestConvert<T, cmatrix4_layout, LayoutA>("cmatrix4", nameA, bounds, threadCount);
+	TestConvert<T, cmatrix4m_layout, LayoutA>("cmatrix4m", nameA, bounds, threadCount);
+	TestConvert<T, cmatrix4m_layout64, LayoutA>("cmatrix4m64", nameA, bounds, threadCount);
+	TestConvert<T, lmatrix4_layout, LayoutA>("lmatrix4", nameA, bounds, threadCount);
+	TestConvert<T, lmatrix4m_layout, LayoutA>("lmatrix4m", nameA, bounds, threadCount);
+	TestConvert<T, lmatrix4m_layout64, LayoutA>("lmatrix4m64", nameA, bounds, threadCount);
+	TestConvert<T, icmatrix4_layout, LayoutA>("icmatrix4", nameA, bounds, threadCount);
+	TestConvert<T, ilmatrix4_layout, LayoutA>("ilmatrix4", nameA, bounds, threadCount);
+	TestConvert<T, dmatrix4_layout64, LayoutA>("dmatrix4", nameA, bounds, threadCount);
+	TestConvert<T, zmatrix4_layout, LayoutA>("zmatrix4", nameA, bounds, threadCount);
+	TestConvert<T, bmatrix4_layout, LayoutA>("bmatrix4", nameA, bounds, threadCount);
+}
+
+/// <summary>
+/// ,  <see cref="matrix4::forEach"/>   (<see cref="matrix4::getCursor"/>)           ,
+///     <see cref="matrix4::at"/>.
+/// </summary>
+template<typename T, template<typename> class Layout>
+static void TestForEach(const char* name, const test_bounds& bounds)
+{
+	matrix4<T, Layout> matrix(bounds, DEFAULT_INITIALIZATION);
+	fillTestValues(matrix, bounds);
+	size_t visits = 0;
+	int mismatches = 0;
+	matrix.forEach([&](T& item, int i1, int i2, int i3, int i4)
+	{
+		visits++;
+		if (&item != &matrix.at(i1, i2, i3, i4) || item != (T)getTestValue(i1, i2, i3, i4))
+			mismatches++;
+	});
+	check(visits == matrix.getLength() && mismatches == 0, "forEach %s: %zu visits for %zu elements, %d differ", name, visits, matrix.getLength(), mismatches);
+
+	//     ,       
+	visits = 0;
+	mismatches = 0;
+	ptrdiff_t previous = -1;
+	matrix4_cursor<T, Layout<T>::order> cursor = matrix.getCursor();
+	while (cursor.moveNext())
+	{
+		visits++;
+		T& item = matrix.at(cursor.getIndex(1), cursor.getIndex(2), cursor.getIndex(3), cursor.getIndex(4));
+		if (&cursor.getCurrent() != &item || cursor.getOffset() <= previous)
+			mismatches++;
+		previous = cursor.getOffset();
+	}
+	check(visits == matrix.getLength() && mismatches == 0, "cursor %s: %zu visits for %zu elements, %d differ or out of order", name, visits, matrix.getLength(), mismatches);
+}
+
+void testLayouts()
+{
+	test_bounds small = { { { -1, 2 }, { 0, 2 }, { 3, 4 }, { -2, 3 } } };
+	test_bounds large = { { { 0, 31 }, { 0, 15 }, { 0, 15 }, { 1, 9 } } };
+	test_bounds uneven = { { { -5, 5 }, { 0, 0 }, { 3, 19 }, { -1, 10 } } };
+	test_bounds tiny = { { { 0, 2 }, { 0, 0 }, { 7, 8 }, { 0, 2 } } };
+	test_bounds powers = { { { 1, 4 }, { -1, 0 }, { 0, 7 }, { 0, 3 } } };
+
+	TestForEach<int64_t, cmatrix4_layout>("cmatrix4", small);
+	TestForEach<int64_t, cmatrix4m_layout>("cmatrix4m", small);
+	TestForEach<int64_t, cmatrix4m_layout64>("cmatrix4m64", small);
+	TestForEach<int64_t, lmatrix4_layout>("lmatrix4", small);
+	TestForEach<int64_t, lmatrix4m_layout>("lmatrix4m", small);
+	TestForEach<int64_t, lmatrix4m_layout64>("lmatrix4m64", small);
+	TestForEach<int64_t, icmatrix4_layout>("icmatrix4", small);
+	TestForEach<int64_t, ilmatrix4_layout>("ilmatrix4", small);
+	TestForEach<int64_t, dmatrix4_layout64>("dmatrix4", small);
+	TestForEach<int64_t, zmatrix4_layout>("zmatrix4", small);
+	TestForEach<int64_t, bmatrix4_layout>("bmatrix4", small);
+
+	// ,    ,          ,       
+	TestForEach<int64_t, zmatrix4_layout>("zmatrix4 11x1x17x12", uneven);
+	TestForEach<int64_t, bmatrix4_layout>("bmatrix4 11x1x17x12", uneven);
+	TestForEach<int64_t, zmatrix4_layout>("zmatrix4 3x1x2x3", tiny);
+	TestForEach<int64_t, zmatrix4_layout>("zmatrix4 4x2x8x4", powers);
+
+	TestConvertFrom<int64_t, cmatrix4_layout>("cmatrix4", small, 1);
+	TestConvertFrom<int64_t, cmatrix4m_layout>("cmatrix4m", small, 1);
+	TestConvertFrom<int64_t, cmatrix4m_layout64>("cmatrix4m64", small, 1);
+	TestConvertFrom<int64_t, lmatrix4_layout>("lmatrix4", small, 1);
+	TestConvertFrom<int64_t, lmatrix4m_layout>("lmatrix4m", small, 1);
+	TestConvertFrom<int64_t, lmatrix4m_layout64>("lmatrix4m64", small, 1);
+	TestConvertFrom<int64_t, icmatrix4_layout>("icmatrix4", small, 1);
+	TestConvertFrom<int64_t, ilmatrix4_layout>("ilmatrix4", small, 1);
+	TestConvertFrom<int64_t, dmatrix4_layout64>("dmatrix4", small, 1);
+	TestConvertFrom<int64_t, zmatrix4_layout>("zmatrix4", small, 1);
+	TestConvertFrom<int64_t, bmatrix4_layout>("bmatrix4", small, 1);
+	TestConvertFrom<int32_t, lmatrix4m_layout64>("lmatrix4m64<int32_t>", small, 1);
+
+	//   PARALLEL_THRESHOLD     
+	TestConvertFrom<int64_t, lmatrix4_layout>("lmatrix4", large, 4);
+	TestConvertFrom<int64_t, icmatrix4_layout>("icmatrix4", large, 4);
+	TestConvertFrom<int64_t, zmatrix4_layout>("zmatrix4", large, 4);
+}
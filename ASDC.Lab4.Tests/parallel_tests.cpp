@@ -0,0 +1,99 @@
+#include "stdafx.h"
+
+
+/// <summary>
+///       ,       .
+/// </summary>
+static int GetFactor(int i1, int i2, int i3, int i4)
+{
+	return (i1 + 2 * i2 + 3 * i3 + 5 * i4) % 7 - 3;
+}
+
+/// <summary>
+///  ,     <see cref="matrix4_parallel"/>       <see cref="matrix4::at"/>.
+/// </summary>
+template<typename T, template<typename> class Layout>
+static void TestParallel(const char* name, const test_bounds& bounds, unsigned threadCount)
+{
+	matrix4<T, Layout> a(bounds, DEFAULT_INITIALIZATION);
+	matrix4<T, lmatrix4_layout> rows(bounds, DEFAULT_INITIALIZATION);
+	matrix4<T, cmatrix4_layout> columns(bounds, DEFAULT_INITIALIZATION);
+	fillTestValues(a, bounds);
+	T sum = 0, dot = 0, maximum = std::numeric_limits<T>::lowest();
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		T item = a.at(i1, i2, i3, i4);
+		rows.at(i1, i2, i3, i4) = columns.at(i1, i2, i3, i4) = (T)GetFactor(i1, i2, i3, i4);
+		sum += item;
+		dot += item * (T)GetFactor(i1, i2, i3, i4);
+		maximum = maximum < item ? item : maximum;
+	});
+
+	check(matrix4_parallel::sum(a, threadCount) == sum, "sum %s: differs from the sum over at()", name);
+	check(matrix4_parallel::dot(a, rows, threadCount) == dot, "dot %s x lmatrix4: differs from the sum over at()", name);
+	check(matrix4_parallel::dot(a, columns, threadCount) == dot, "dot %s x cmatrix4: differs from the sum over at()", name);
+	check(matrix4_parallel::dot(rows, a, threadCount) == dot, "dot lmatrix4 x %s: differs from the sum over at()", name);
+	check(matrix4_parallel::reduce(a, std::numeric_limits<T>::lowest(), [](const T& x, const T& y) { return x < y ? y : x; }, threadCount) == maximum,
+		"reduce %s: differs from the maximum over at()", name);
+
+	int mismatches = 0;
+	matrix4<T, Layout> result(bounds, VALUE_INITIALIZATION);
+	matrix4_parallel::transform(result, a, columns, [](const T& x, const T& y) { return x - y; }, threadCount);
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		if (result.at(i1, i2, i3, i4) != a.at(i1, i2, i3, i4) - columns.at(i1, i2, i3, i4))
+			mismatches++;
+	});
+	check(mismatches == 0, "transform %s - cmatrix4: %d elements differ", name, mismatches);
+
+	mismatches = 0;
+	matrix4_parallel::transform(a, a, [](const T& x) { return x * 2 + 1; }, threadCount);
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		if (a.at(i1, i2, i3, i4) != (T)getTestValue(i1, i2, i3, i4) * 2 + 1)
+			mismatches++;
+	});
+	check(mismatches == 0, "transform %s in place: %d elements differ", name, mismatches);
+
+	mismatches = 0;
+	matrix4_parallel::fill(a, (T)-5, threadCount);
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		if (a.at(i1, i2, i3, i4) != (T)-5)
+			mismatches++;
+	});
+	check(mismatches == 0, "fill %s: %d elements differ", name, mismatches);
+}
+
+/// <summary>
+///  <see cref="TestParallel"/>     .
+/// </summary>
+template<typename T>
+static void TestParallel(const test_bounds& bounds, unsigned threadCount)
+{
+	TestParallel<T, lmatrix4_layout>("lmatrix4", bounds, threadCount);
+	TestParallel<T, lmatrix4m_layout>("lmatrix4m", bounds, threadCount);
+	TestParallel<T, lmatrix4m_layout64>("lmatrix4m64", bounds, threadCount);
+	TestParallel<T, cmatrix4_layout>("cmatrix4", bounds, threadCount);
+	TestParallel<T, cmatrix4m_layout>("cmatrix4m", bounds, threadCount);
+	TestParallel<T, cmatrix4m_layout64>("cmatrix4m64", bounds, threadCount);
+	TestParallel<T, ilmatrix4_layout>("ilmatrix4", bounds, threadCount);
+	TestParallel<T, icmatrix4_layout>("icmatrix4", bounds, threadCount);
+	TestParallel<T, dmatrix4_layout64>("dmatrix4", bounds, threadCount);
+}
+
+void testParallel()
+{
+	test_bounds small = { { { -1, 2 }, { 0, 2 }, { 3, 4 }, { -2, 3 } } };
+	test_bounds fewSlabs = { { { 0, 31 }, { 0, 15 }, { 0, 15 }, { 1, 9 } } };
+	test_bounds manySlabs = { { { 0, 299 }, { 0, 3 }, { 0, 3 }, { -8, 7 } } };
+
+	TestParallel<int32_t>(small, 1);
+	TestParallel<int64_t>(small, 1);
+	TestParallel<double>(small, 1);
+
+	//   PARALLEL_THRESHOLD      ,   ,  
+	TestParallel<int64_t>(fewSlabs, 4);
+	TestParallel<double>(fewSlabs, 3);
+	TestParallel<int64_t>(manySlabs, 4);
+}
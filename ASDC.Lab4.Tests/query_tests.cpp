@@ -0,0 +1,264 @@
+#include "stdafx.h"
+
+
+/// <summary>
+///      ,     .
+/// </summary>
+#define QUERY_TEST_FILE "ASDC.Lab4.Tests.citizens.bin"
+
+/// <summary>
+///         ,      .
+/// </summary>
+struct query_model
+{
+	citizen_query query;
+	unsigned genders = (1 << MALE) | (1 << FEMALE);
+	int64_t pinLow = INT64_MIN, pinHigh = INT64_MAX;
+	int32_t birthLow = INT32_MIN, birthHigh = INT32_MAX;
+	int yearFrom = (std::numeric_limits<int>::min)(), yearTo = (std::numeric_limits<int>::max)();
+	std::vector<std::string> firstNames, lastNames;
+	std::vector<std::array<int, 8>> boxes;
+
+	query_model& whereGender(GENDER gender)
+	{
+		query.whereGender(gender);
+		genders &= 1 << gender;
+		return *this;
+	}
+
+	query_model& wherePin(int64_t low, int64_t high)
+	{
+		query.wherePin(low, high);
+		pinLow = (std::max)(pinLow, low);
+		pinHigh = (std::min)(pinHigh, high);
+		return *this;
+	}
+
+	query_model& whereBirth(int32_t low, int32_t high)
+	{
+		query.whereBirth(low, high);
+		birthLow = (std::max)(birthLow, low);
+		birthHigh = (std::min)(birthHigh, high);
+		return *this;
+	}
+
+	query_model& whereBirthYear(int from, int to)
+	{
+		query.whereBirthYear(from, to);
+		yearFrom = (std::max)(yearFrom, from);
+		yearTo = (std::min)(yearTo, to);
+		return *this;
+	}
+
+	query_model& whereFirstName(const char* prefix)
+	{
+		query.whereFirstName(prefix);
+		firstNames.push_back(prefix);
+		return *this;
+	}
+
+	query_model& whereLastName(const char* prefix)
+	{
+		query.whereLastName(prefix);
+		lastNames.push_back(prefix);
+		return *this;
+	}
+
+	query_model& within(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h)
+	{
+		query.within(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h);
+		boxes.push_back({ { i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h } });
+		return *this;
+	}
+
+	/// <summary>
+	/// ,          .
+	/// </summary>
+	bool isInside(const int (&index)[4]) const
+	{
+		for (const std::array<int, 8>& box : boxes)
+			for (int d = 0; d < 4; d++)
+				if (index[d] < box[2 * d] || index[d] > box[2 * d + 1])
+					return false;
+		return true;
+	}
+
+	/// <summary>
+	/// ,         ,     .
+	/// </summary>
+	bool isContradictory() const
+	{
+		return genders == 0 || pinLow > pinHigh || birthLow > birthHigh || yearFrom > yearTo || !isConsistent(firstNames) || !isConsistent(lastNames);
+	}
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	bool isMatch(const citizen_table& table, size_t row) const
+	{
+		int64_t pin = table.getPin(row);
+		int32_t birth = citizen_table::packBirth(table.getDay(row), table.getMonth(row), table.getYear(row));
+		if ((genders & (1 << table.getGender(row))) == 0 || pin < pinLow || pin > pinHigh || birth < birthLow || birth > birthHigh ||
+			table.getYear(row) < yearFrom || table.getYear(row) > yearTo)
+			return false;
+		for (const std::string& prefix : firstNames)
+			if (!isPrefix(prefix, table.getFirstName(row)))
+				return false;
+		for (const std::string& prefix : lastNames)
+			if (!isPrefix(prefix, table.getLastName(row)))
+				return false;
+		return true;
+	}
+
+private:
+	static bool isPrefix(std::string_view prefix, std::string_view name)
+	{
+		return name.substr(0, prefix.size()) == prefix;
+	}
+
+	static bool isConsistent(const std::vector<std::string>& prefixes)
+	{
+		for (const std::string& a : prefixes)
+			for (const std::string& b : prefixes)
+				if (!isPrefix(a, b) && !isPrefix(b, a))
+					return false;
+		return true;
+	}
+};
+
+/// <summary>
+///   ,   ,    ,     .
+/// </summary>
+static uint32_t Mix(uint32_t value)
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+	return value;
+}
+
+bool writeCitizens(const char* path, int count)
+{
+	static const char* const firstNames[] = { "Anna", "Andrey", "Ann", "A", "Boris", "Bogdan", "Vera", "Viktor", "Galina" };
+	static const char* const lastNames[] = { "Petrov", "Petrova", "Pe", "", "Ivanov", "Ivanova", "Sidorov", "Smirnova" };
+	FILE* file = fopen(path, "wb");
+	if (!check(file != nullptr, "cannot create %s", path))
+		return false;
+	fwrite(&count, sizeof(int), 1, file);
+	for (int row = 0; row < count; row++)
+	{
+		uint32_t hash[7];
+		for (int k = 0; k < 7; k++)
+			hash[k] = Mix((uint32_t)row * 8 + k);
+		int64_t pin = 4000000000000 + (int64_t)(hash[0] % 1000000007u);
+		const char* names[2] = { firstNames[hash[1] % 9], lastNames[hash[2] % 8] };
+		int fields[4] = { 1 + (int)(hash[3] % 28), 1 + (int)(hash[4] % 12), 1940 + (int)(hash[5] % 66), row >= 10000 && row < 10200 ? FEMALE : (int)(hash[6] & 1) };
+		fwrite(&pin, sizeof(int64_t), 1, file);
+		for (const char* name : names)
+		{
+			int length = (int)strlen(name);
+			fwrite(&length, sizeof(int), 1, file);
+			fwrite(name, 1, length, file);
+		}
+		fwrite(fields, sizeof(int), 4, file);
+	}
+	fclose(file);
+	return true;
+}
+
+/// <summary>
+///         ,           .
+/// </summary>
+static void TestQuery(const char* name, const query_model& model, const citizen_table& table, const int (&bounds)[4][2], unsigned threadCount)
+{
+	std::vector<size_t> rows;
+	std::vector<std::array<int, 4>> indices;
+	size_t scanned = 0;
+	for (size_t row = 0; row < table.getCount(); row++)
+	{
+		//       ROW_MAJOR
+		int index[4];
+		size_t rest = row;
+		for (int d = 3; d >= 0; d--)
+		{
+			size_t extent = (size_t)(bounds[d][1] - bounds[d][0] + 1);
+			index[d] = bounds[d][0] + (int)(rest % extent);
+			rest /= extent;
+		}
+		if (!model.isInside(index))
+			continue;
+		scanned++;
+		if (model.isMatch(table, row))
+		{
+			rows.push_back(row);
+			indices.push_back({ { index[0], index[1], index[2], index[3] } });
+		}
+	}
+	if (model.isContradictory())
+		scanned = 0;
+
+	citizen_selection selection = model.query.execute(table, bounds, threadCount);
+	check(selection.rows == rows, "query %s, %u threads: %zu rows instead of %zu or different rows", name, threadCount, selection.rows.size(), rows.size());
+	check(selection.indices == indices, "query %s, %u threads: different indices", name, threadCount);
+	check(selection.scanned == scanned, "query %s, %u threads: %zu rows scanned instead of %zu", name, threadCount, selection.scanned, scanned);
+}
+
+void testQuery()
+{
+	const int bounds[4][2] = { { 1, 10 }, { 0, 6 }, { -2, 7 }, { 0, 99 } };
+	int count = 10 * 7 * 10 * 100;
+	temporary_file path = { QUERY_TEST_FILE };
+	if (!writeCitizens(path.path, count))
+		return;
+	citizen_file file(path.path);
+	citizen_table table(file);
+	check(table.getCount() == (size_t)count, "citizen_table: %zu rows instead of %d", table.getCount(), count);
+
+	int lowest = (std::numeric_limits<int>::min)(), highest = (std::numeric_limits<int>::max)();
+	std::vector<std::pair<const char*, query_model>> cases(15);
+	cases[0].first = "all";
+	cases[1].first = "gender";
+	cases[1].second.whereGender(FEMALE);
+	cases[2].first = "pin";
+	cases[2].second.wherePin(4000100000000, 4000200000000).wherePin(4000000000000, 4000150000000);
+	cases[3].first = "birth year";
+	cases[3].second.whereBirthYear(1960, 1969);
+	cases[4].first = "birth";
+	cases[4].second.whereBirth(citizen_table::packBirth(15, 6, 1950), citizen_table::packBirth(1, 3, 1990));
+	cases[5].first = "first name";
+	cases[5].second.whereFirstName("An");
+	cases[6].first = "narrowed names";
+	cases[6].second.whereFirstName("A").whereFirstName("Ann").whereLastName("Pe").whereLastName("Petrov");
+	cases[7].first = "contradictory names";
+	cases[7].second.whereFirstName("Bo").whereFirstName("Ve");
+	cases[8].first = "contradictory pin";
+	cases[8].second.wherePin(4000000000000, 4000000100000).wherePin(4000000200000, 4000000300000);
+	cases[9].first = "combined";
+	cases[9].second.whereGender(MALE).whereBirthYear(1950, 1990).whereLastName("Iv").wherePin(4000000000000, 4000700000000);
+	cases[10].first = "slab";
+	cases[10].second.within(3, 5, lowest, highest, lowest, highest, lowest, highest).whereGender(FEMALE);
+	cases[11].first = "box";
+	cases[11].second.within(-100, 100, 2, 3, 0, 0, 10, 20).whereFirstName("Vi");
+	cases[12].first = "narrowed box";
+	cases[12].second.within(2, 9, 1, 5, -2, 7, 0, 99).within(4, 20, -5, 3, -1, 4, 50, 60);
+	cases[13].first = "lines";
+	cases[13].second.within(1, 10, 0, 6, -2, 7, 40, 41).whereBirthYear(1970, 2005);
+	cases[14].first = "outside";
+	cases[14].second.within(20, 30, 0, 6, -2, 7, 0, 99);
+
+	for (const std::pair<const char*, query_model>& c : cases)
+	{
+		TestQuery(c.first, c.second, table, bounds, 1);
+		TestQuery(c.first, c.second, table, bounds, 4);
+	}
+
+	int thrown = 0;
+	const int mismatched[4][2] = { { 1, 10 }, { 0, 6 }, { -2, 7 }, { 0, 98 } };
+	const int reversed[4][2] = { { 1, 10 }, { 6, 0 }, { -2, 7 }, { 0, 99 } };
+	try { citizen_query().execute(table, mismatched); } catch (const std::invalid_argument&) { thrown++; }
+	try { citizen_query().execute(table, reversed); } catch (const std::invalid_argument&) { thrown++; }
+	try { citizen_query().within(0, 1, 0, 1, 1, 0, 0, 1); } catch (const std::invalid_argument&) { thrown++; }
+	check(thrown == 3, "query: %d of 3 invalid calls threw std::invalid_argument", thrown);
+}
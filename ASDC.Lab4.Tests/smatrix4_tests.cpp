@@ -0,0 +1,165 @@
+#include "stdafx.h"
+
+
+/// <summary>
+///    :     ,    <see cref="matrix4::at"/>.
+/// </summary>
+struct sparse_model
+{
+	matrix4<int64_t, lmatrix4_layout> values;
+	matrix4<char, lmatrix4_layout> filled;
+
+	sparse_model(const test_bounds& bounds) : values(bounds, VALUE_INITIALIZATION), filled(bounds, VALUE_INITIALIZATION)
+	{
+	}
+
+	void set(int i1, int i2, int i3, int i4, int64_t value)
+	{
+		values.at(i1, i2, i3, i4) = value;
+		filled.at(i1, i2, i3, i4) = 1;
+	}
+};
+
+/// <summary>
+///       : <see cref="smatrix4::find"/>        <see cref="smatrix4::forEach"/>.
+/// </summary>
+static void CheckSparse(const char* stage, smatrix4<int64_t>& matrix, sparse_model& model, const test_bounds& bounds)
+{
+	size_t count = 0;
+	int mismatches = 0;
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		int64_t* item = matrix.find(i1, i2, i3, i4);
+		if (model.filled.at(i1, i2, i3, i4))
+		{
+			count++;
+			if (item == nullptr || *item != model.values.at(i1, i2, i3, i4))
+				mismatches++;
+		}
+		else if (item != nullptr)
+			mismatches++;
+	});
+	check(mismatches == 0, "smatrix4 %s: find differs for %d elements", stage, mismatches);
+	check(matrix.getCount() == count, "smatrix4 %s: getCount returns %zu instead of %zu", stage, matrix.getCount(), count);
+
+	//     lmatrix4,       
+	int lowest = (std::numeric_limits<int>::min)();
+	std::array<int, 4> previous = { { lowest, lowest, lowest, lowest } };
+	size_t visits = 0;
+	mismatches = 0;
+	matrix.forEach([&](int64_t& item, int i1, int i2, int i3, int i4)
+	{
+		std::array<int, 4> index = { { i1, i2, i3, i4 } };
+		visits++;
+		if (!(previous < index) || !model.filled.at(i1, i2, i3, i4) || item != model.values.at(i1, i2, i3, i4))
+			mismatches++;
+		previous = index;
+	});
+	check(visits == count && mismatches == 0, "smatrix4 %s: forEach visits %zu of %zu elements, %d out of order or different", stage, visits, count, mismatches);
+}
+
+/// <summary>
+/// ,       <c>std::out_of_range</c>    .
+/// </summary>
+static void CheckOutOfRange(smatrix4<int64_t>& matrix, int i1, int i2, int i3, int i4)
+{
+	size_t count = matrix.getCount();
+	int thrown = 0;
+	try { matrix.at(i1, i2, i3, i4); } catch (const std::out_of_range&) { thrown++; }
+	try { matrix.find(i1, i2, i3, i4); } catch (const std::out_of_range&) { thrown++; }
+	try { matrix.emplace(i1, i2, i3, i4, 1); } catch (const std::out_of_range&) { thrown++; }
+	int indices[2][4] = { { 0, 0, 0, 1 }, { i1, i2, i3, i4 } };
+	int64_t values[2] = { 1, 2 };
+	try { matrix.insert(indices, values, 2); } catch (const std::out_of_range&) { thrown++; }
+	check(thrown == 4 && matrix.getCount() == count, "smatrix4 (%d, %d, %d, %d): %d of 4 calls threw std::out_of_range, count %zu -> %zu", i1, i2, i3, i4, thrown, count, matrix.getCount());
+}
+
+void testSparse()
+{
+	test_bounds bounds = { { { -3, 4 }, { 0, 9 }, { -5, 5 }, { 1, 12 } } };
+	smatrix4<int64_t> matrix(bounds[0][0], bounds[0][1], bounds[1][0], bounds[1][1], bounds[2][0], bounds[2][1], bounds[3][0], bounds[3][1]);
+	sparse_model model(bounds);
+	check(matrix.getLength() == model.values.getLength(), "smatrix4: getLength returns %zu instead of %zu", matrix.getLength(), model.values.getLength());
+	for (int d = 1; d <= 4; d++)
+		check(matrix.getLength(d) == model.values.getLength(d) && matrix.getLowerBound(d) == bounds[d - 1][0] && matrix.getUpperBound(d) == bounds[d - 1][1],
+			"smatrix4: dimension %d has different bounds", d);
+	CheckSparse("empty", matrix, model, bounds);
+
+	//      -     
+	std::mt19937 random(20181017);
+	std::uniform_int_distribution<int> operation(0, 3);
+	std::uniform_int_distribution<int64_t> value(-1000000, 1000000);
+	std::uniform_int_distribution<int> index[4] =
+	{
+		std::uniform_int_distribution<int>(bounds[0][0], bounds[0][1]), std::uniform_int_distribution<int>(bounds[1][0], bounds[1][1]),
+		std::uniform_int_distribution<int>(bounds[2][0], bounds[2][1]), std::uniform_int_distribution<int>(bounds[3][0], bounds[3][1])
+	};
+	int mismatches = 0;
+	for (int k = 0; k < 4000; k++)
+	{
+		int i1 = index[0](random), i2 = index[1](random), i3 = index[2](random), i4 = index[3](random);
+		int64_t v = value(random);
+		switch (operation(random))
+		{
+		case 0:
+			matrix.at(i1, i2, i3, i4) = v;
+			model.set(i1, i2, i3, i4, v);
+			break;
+		case 1:
+			if (matrix.emplace(i1, i2, i3, i4, v) != v)
+				mismatches++;
+			model.set(i1, i2, i3, i4, v);
+			break;
+		case 2:
+			//         
+			if (!model.filled.at(i1, i2, i3, i4))
+				model.set(i1, i2, i3, i4, 0);
+			if (matrix.at(i1, i2, i3, i4) != model.values.at(i1, i2, i3, i4))
+				mismatches++;
+			break;
+		default:
+		{
+			int64_t* item = matrix.find(i1, i2, i3, i4);
+			if (model.filled.at(i1, i2, i3, i4) ? item == nullptr || *item != model.values.at(i1, i2, i3, i4) : item != nullptr)
+				mismatches++;
+			break;
+		}
+		}
+	}
+	check(mismatches == 0, "smatrix4 random: %d operations returned a different element", mismatches);
+	CheckSparse("random", matrix, model, bounds);
+
+	//     ;     
+	std::vector<std::array<int, 4>> indices;
+	std::vector<int64_t> values;
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		if ((i1 * 7 + i2 * 5 + i3 * 3 + i4) % 11 == 0)
+		{
+			indices.push_back({ { i1, i2, i3, i4 } });
+			values.push_back(value(random));
+		}
+	});
+	std::shuffle(indices.begin(), indices.end(), random);
+	matrix.insert((const int (*)[4])indices.data(), values.data(), values.size());
+	for (size_t k = 0; k < values.size(); k++)
+		model.set(indices[k][0], indices[k][1], indices[k][2], indices[k][3], values[k]);
+	CheckSparse("insert", matrix, model, bounds);
+
+	CheckOutOfRange(matrix, bounds[0][0] - 1, 0, 0, 1);
+	CheckOutOfRange(matrix, 0, bounds[1][1] + 1, 0, 1);
+	CheckOutOfRange(matrix, 0, 0, bounds[2][0] - 1, 1);
+	CheckOutOfRange(matrix, 0, 0, 0, bounds[3][1] + 1);
+	CheckSparse("out of range", matrix, model, bounds);
+
+	matrix.clear();
+	sparse_model empty(bounds);
+	CheckSparse("clear", matrix, empty, bounds);
+
+	//        
+	std::sort(indices.begin(), indices.end());
+	matrix.insert((const int (*)[4])indices.data(), values.data(), values.size());
+	for (size_t k = 0; k < values.size(); k++)
+		empty.set(indices[k][0], indices[k][1], indices[k][2], indices[k][3], values[k]);
+	CheckSparse("sorted insert", matrix, empty, bounds);
+}
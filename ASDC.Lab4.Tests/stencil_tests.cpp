@@ -0,0 +1,115 @@
+#include "stdafx.h"
+
+
+/// <summary>
+///      <see cref="matrix4_stencil::apply"/>,     <see cref="matrix4::at"/>.
+/// </summary>
+template<typename T, template<typename> class Layout>
+static T GetStencilValue(matrix4<T, Layout>& source, const stencil4<T>& stencil, STENCIL_OPERATION operation, STENCIL_BOUNDARY boundary, const int (&index)[4])
+{
+	T value = operation == STENCIL_MINIMUM ? (std::numeric_limits<T>::max)() : operation == STENCIL_MAXIMUM ? std::numeric_limits<T>::lowest() : 0;
+	T total = 0, counted = 0;
+	for (size_t p = 0; p < stencil.getCount(); p++)
+	{
+		T weight = stencil.getWeight(p);
+		total += weight;
+		int neighbor[4];
+		bool inside = true;
+		for (int d = 0; d < 4; d++)
+		{
+			int lower = source.getLowerBound(d + 1), length = source.getLength(d + 1);
+			int k = index[d] - lower + stencil.getOffset(p, d + 1);
+			if (k < 0 || k >= length)
+			{
+				if (boundary == BOUNDARY_SKIP)
+					inside = false;
+				else if (boundary == BOUNDARY_CLAMP)
+					k = k < 0 ? 0 : length - 1;
+				else
+					k = (k % length + length) % length;
+			}
+			neighbor[d] = lower + k;
+		}
+		if (!inside)
+			continue;
+		T item = source.at(neighbor[0], neighbor[1], neighbor[2], neighbor[3]);
+		if (operation == STENCIL_MINIMUM)
+			value = item < value ? item : value;
+		else if (operation == STENCIL_MAXIMUM)
+			value = value < item ? item : value;
+		else
+			value += weight * item;
+		counted += weight;
+	}
+	if (operation == STENCIL_AVERAGE)
+	{
+		T divisor = boundary == BOUNDARY_SKIP ? counted : total;
+		value = divisor != 0 ? value / divisor : 0;
+	}
+	return value;
+}
+
+/// <summary>
+///         <see cref="GetStencilValue"/>       .
+/// </summary>
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+static void TestStencil(const char* name, const test_bounds& bounds, const stencil4<T>& stencil, unsigned threadCount)
+{
+	static const char* const operations[] = { "sum", "average", "minimum", "maximum" };
+	static const char* const boundaries[] = { "clamp", "skip", "periodic" };
+	matrix4<T, LayoutA> source(bounds, DEFAULT_INITIALIZATION);
+	fillTestValues(source, bounds);
+	matrix4<T, Layout> result(bounds, VALUE_INITIALIZATION);
+	for (int operation = STENCIL_SUM; operation <= STENCIL_MAXIMUM; operation++)
+		for (int boundary = BOUNDARY_CLAMP; boundary <= BOUNDARY_PERIODIC; boundary++)
+		{
+			matrix4_stencil::apply(result, source, stencil, (STENCIL_OPERATION)operation, (STENCIL_BOUNDARY)boundary, threadCount);
+			int mismatches = 0;
+			forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+			{
+				int index[4] = { i1, i2, i3, i4 };
+				if (result.at(i1, i2, i3, i4) != GetStencilValue(source, stencil, (STENCIL_OPERATION)operation, (STENCIL_BOUNDARY)boundary, index))
+					mismatches++;
+			});
+			check(mismatches == 0, "stencil %s, %s, %s: %d elements differ", name, operations[operation], boundaries[boundary], mismatches);
+		}
+}
+
+/// <summary>
+///       ,     .
+/// </summary>
+template<typename T>
+static stencil4<T> GetWeightedStencil()
+{
+	stencil4<T> result;
+	result.add(0, 0, 0, 0, 3);
+	result.add(-1, 0, 2, 0, 2);
+	result.add(0, 3, 0, -1, 1);
+	result.add(5, 0, 0, 0, 4);
+	result.add(0, 0, 0, -7, 2);
+	return result;
+}
+
+void testStencil()
+{
+	test_bounds small = { { { -1, 2 }, { 0, 2 }, { 3, 4 }, { -2, 3 } } };
+	test_bounds longLines = { { { 0, 1 }, { 0, 2 }, { 0, 1 }, { -5, 1100 } } };
+	test_bounds longColumns = { { { -5, 1100 }, { 0, 2 }, { 0, 1 }, { 0, 1 } } };
+	test_bounds large = { { { 0, 31 }, { 0, 15 }, { 0, 15 }, { 1, 9 } } };
+
+	TestStencil<int64_t, lmatrix4_layout, lmatrix4_layout>("lmatrix4 neighborhood", small, stencil4<int64_t>::getNeighborhood(), 1);
+	TestStencil<int64_t, lmatrix4_layout, lmatrix4_layout>("lmatrix4 box", small, stencil4<int64_t>::getBox(1), 1);
+	TestStencil<int64_t, lmatrix4_layout, lmatrix4_layout>("lmatrix4 weighted", small, GetWeightedStencil<int64_t>(), 1);
+	TestStencil<int64_t, cmatrix4_layout, cmatrix4m_layout64>("cmatrix4 weighted", small, GetWeightedStencil<int64_t>(), 1);
+	TestStencil<int64_t, lmatrix4m_layout64, ilmatrix4_layout>("ilmatrix4 weighted", small, GetWeightedStencil<int64_t>(), 1);
+	TestStencil<int64_t, icmatrix4_layout, cmatrix4_layout>("icmatrix4 box", small, stencil4<int64_t>::getBox(1), 1);
+	TestStencil<int32_t, lmatrix4m_layout, lmatrix4_layout>("int32 weighted", small, GetWeightedStencil<int32_t>(), 1);
+	TestStencil<double, lmatrix4m_layout64, lmatrix4_layout>("double weighted", small, GetWeightedStencil<double>(), 1);
+
+	//   BLOCK_LENGTH   
+	TestStencil<int64_t, lmatrix4_layout, lmatrix4m_layout64>("long lines", longLines, GetWeightedStencil<int64_t>(), 1);
+	TestStencil<int64_t, cmatrix4m_layout64, cmatrix4_layout>("long columns", longColumns, GetWeightedStencil<int64_t>(), 1);
+
+	//   PARALLEL_THRESHOLD   
+	TestStencil<int64_t, lmatrix4_layout, lmatrix4_layout>("parallel", large, stencil4<int64_t>::getNeighborhood(), 4);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+/// <summary>
+///    :      .
+/// </summary>
+typedef std::array<std::array<int, 2>, 4> test_bounds;
+
+/// <summary>
+///  ,  .
+/// </summary>
+extern int testFailures;
+
+/// <summary>
+///    ,    ,   .
+/// </summary>
+/// <param name='condition'> .</param>
+/// <param name='format'>   ,   <c>printf</c>.</param>
+/// <returns> <paramref name="condition"/>.</returns>
+bool check(bool condition, const char* format, ...);
+
+/// <summary>
+///      <see cref="citizen_file::readParallel"/>       <see cref="citizen_file::read"/>.
+/// </summary>
+void testFile();
+
+/// <summary>
+///      <see cref="matrix4_kernels"/>          <see cref="matrix4::at"/>.
+/// </summary>
+void testKernels();
+
+/// <summary>
+///   <see cref="matrix4_parallel::convert"/>      <see cref="matrix4::forEach"/>    <see cref="matrix4::at"/>.
+/// </summary>
+void testLayouts();
+
+/// <summary>
+///  ,  ,     <see cref="matrix4_parallel"/>    <see cref="matrix4::at"/>.
+/// </summary>
+void testParallel();
+
+/// <summary>
+///   <see cref="citizen_query::execute"/>          .
+/// </summary>
+void testQuery();
+
+/// <summary>
+///    <see cref="smatrix4"/>   ,       ,   <see cref="matrix4::at"/>.
+/// </summary>
+void testSparse();
+
+/// <summary>
+///   <see cref="matrix4_stencil::apply"/>     <see cref="matrix4::at"/>       .
+/// </summary>
+void testStencil();
+
+/// <summary>
+///        .
+/// </summary>
+struct temporary_file
+{
+	const char* path;
+
+	~temporary_file()
+	{
+		remove(path);
+	}
+};
+
+/// <summary>
+///        <see cref="citizen_file"/>;      .
+/// </summary>
+/// <returns> true,    .</returns>
+bool writeCitizens(const char* path, int count);
+
+/// <summary>
+///  ,        ;       .
+/// </summary>
+inline int64_t getTestValue(int i1, int i2, int i3, int i4)
+{
+	return (int64_t)i1 * 1000003 - (int64_t)i2 * 10007 + (int64_t)i3 * 101 - (int64_t)i4 * 7 + ((i1 ^ i2 ^ i3 ^ i4) & 15);
+}
+
+template<typename Visitor>
+/// <summary>
+///          <c>ROW_MAJOR</c>:     .
+/// </summary>
+/// <param name='bounds'> .</param>
+/// <param name='visitor'> <c>visitor(int i1, int i2, int i3, int i4)</c>.</param>
+inline void forEachIndex(const test_bounds& bounds, Visitor visitor)
+{
+	for (int i1 = bounds[0][0]; i1 <= bounds[0][1]; i1++)
+		for (int i2 = bounds[1][0]; i2 <= bounds[1][1]; i2++)
+			for (int i3 = bounds[2][0]; i3 <= bounds[2][1]; i3++)
+				for (int i4 = bounds[3][0]; i4 <= bounds[3][1]; i4++)
+					visitor(i1, i2, i3, i4);
+}
+
+template<typename T, template<typename> class Layout>
+/// <summary>
+///       <see cref="matrix4::at"/>  <see cref="getTestValue"/>  .
+/// </summary>
+inline void fillTestValues(matrix4<T, Layout>& matrix, const test_bounds& bounds)
+{
+	forEachIndex(bounds, [&](int i1, int i2, int i3, int i4)
+	{
+		matrix.at(i1, i2, i3, i4) = (T)getTestValue(i1, i2, i3, i4);
+	});
+}
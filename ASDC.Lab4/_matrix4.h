@@ -7,6 +7,11 @@ template<typename T>
 class _matrix4
 {
 public:
+	/// <summary>
+	///   ,  <see cref="_matrix4"/>.
+	/// </summary>
+	virtual ~_matrix4() {}
+
 	/// <summary>
 	///       .
 	/// </summary>
@@ -41,6 +46,12 @@ public:
 	/// <returns>32-    ,        .</returns>
 	virtual int getMulCount() = 0;
 
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	virtual int getIndirectionCount() = 0;
+
 	/// <summary>
 	///        .
 	/// </summary>
@@ -0,0 +1,195 @@
+#pragma once
+
+/// <summary>
+///    <see cref="address_counter"/>;         .
+/// </summary>
+#define ADDRESS_HISTOGRAM_SIZE 16
+
+/// <summary>
+///   ,     .
+/// </summary>
+enum ADDRESS_OPERATION : int
+{
+	ADDITION, MULTIPLICATION, INDIRECTION, BOUNDS_CHECK
+};
+
+/// <summary>
+///   ,        .
+/// </summary>
+/// <remarks>
+///  ,       <c>MATRIX4_INSTRUMENTATION</c>;
+///  <see cref="MATRIX4_COUNT"/>  <see cref="MATRIX4_COUNT_SCOPE"/>    ,  <see cref="counted_layout"/>   .
+/// </remarks>
+class address_counter
+{
+	size_t calls;
+	size_t total[4];
+	size_t current[4];
+	size_t histogram[4][ADDRESS_HISTOGRAM_SIZE];
+
+public:
+	/// <summary>
+	///    <see cref="address_counter"/>   .
+	/// </summary>
+	address_counter();
+
+	/// <summary>
+	///      .
+	/// </summary>
+	void begin();
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='operation'> .</param>
+	/// <param name='count'>  .</param>
+	void record(ADDRESS_OPERATION operation, int count);
+
+	/// <summary>
+	///             .
+	/// </summary>
+	void end();
+
+	/// <summary>
+	///     .
+	/// </summary>
+	void reset();
+
+	/// <summary>
+	///     .
+	/// </summary>
+	size_t getCallCount() const;
+
+	/// <summary>
+	///           .
+	/// </summary>
+	/// <param name='operation'> .</param>
+	size_t getCount(ADDRESS_OPERATION operation) const;
+
+	/// <summary>
+	///    ,         .
+	/// </summary>
+	/// <param name='operation'> .</param>
+	/// <param name='count'> ;   <c>ADDRESS_HISTOGRAM_SIZE - 1</c>      .</param>
+	size_t getHistogram(ADDRESS_OPERATION operation, int count) const;
+};
+
+#ifdef MATRIX4_INSTRUMENTATION
+/// <summary>
+///  ,    ,     <c>MATRIX4_INSTRUMENTATION</c>.
+/// </summary>
+#define MATRIX4_COUNT(expression) (expression)
+
+/// <summary>
+///   ,     .
+/// </summary>
+class counted_layout
+{
+protected:
+	mutable address_counter counter;
+
+public:
+	/// <summary>
+	///       .
+	/// </summary>
+	address_counter& getCounter() const
+	{
+		return counter;
+	}
+};
+
+/// <summary>
+///    :  <see cref="address_counter::begin"/>    <see cref="address_counter::end"/>  ,
+///     ,     .
+/// </summary>
+class address_scope
+{
+	address_counter& counter;
+
+public:
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <param name='counter'>   .</param>
+	explicit address_scope(address_counter& counter) : counter(counter)
+	{
+		counter.begin();
+	}
+
+	address_scope(const address_scope&) = delete;
+	address_scope& operator=(const address_scope&) = delete;
+
+	/// <summary>
+	///   ,      .
+	/// </summary>
+	~address_scope()
+	{
+		counter.end();
+	}
+};
+
+/// <summary>
+///          ,     <c>MATRIX4_INSTRUMENTATION</c>.
+/// </summary>
+#define MATRIX4_COUNT_SCOPE(counter) address_scope matrix4CountScope(counter)
+#else
+#define MATRIX4_COUNT(expression) ((void)0)
+#define MATRIX4_COUNT_SCOPE(counter) ((void)0)
+
+class counted_layout
+{
+};
+#endif
+
+inline address_counter::address_counter()
+{
+	reset();
+}
+
+inline void address_counter::begin()
+{
+	for (int i = 0; i < 4; i++)
+		current[i] = 0;
+}
+
+inline void address_counter::record(ADDRESS_OPERATION operation, int count)
+{
+	current[operation] += count;
+}
+
+inline void address_counter::end()
+{
+	calls++;
+	for (int i = 0; i < 4; i++)
+	{
+		total[i] += current[i];
+		histogram[i][current[i] < ADDRESS_HISTOGRAM_SIZE ? current[i] : ADDRESS_HISTOGRAM_SIZE - 1]++;
+	}
+}
+
+inline void address_counter::reset()
+{
+	calls = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		total[i] = 0;
+		current[i] = 0;
+		for (int j = 0; j < ADDRESS_HISTOGRAM_SIZE; j++)
+			histogram[i][j] = 0;
+	}
+}
+
+inline size_t address_counter::getCallCount() const
+{
+	return calls;
+}
+
+inline size_t address_counter::getCount(ADDRESS_OPERATION operation) const
+{
+	return total[operation];
+}
+
+inline size_t address_counter::getHistogram(ADDRESS_OPERATION operation, int count) const
+{
+	return histogram[operation][count < ADDRESS_HISTOGRAM_SIZE ? count : ADDRESS_HISTOGRAM_SIZE - 1];
+}
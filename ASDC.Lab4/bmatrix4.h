@@ -0,0 +1,322 @@
+#pragma once
+#include "matrix4_adapter.h"
+
+template<typename T, int S1, int S2, int S3, int S4>
+/// <summary>
+///       <typeparamref name="S1"/>x<typeparamref name="S2"/>x<typeparamref name="S3"/>x<typeparamref name="S4"/>,
+///              .
+/// </summary>
+/// <remarks>
+///       (       ),       .
+///     ,              ,
+///        ;      <see cref="tileLength"/>    .
+///        ,     ;     ,
+///              .
+///        <see cref="matrix4"/>  -,  <see cref="bmatrix4_layout"/>.
+/// </remarks>
+class bmatrix4_tiled_layout : public counted_layout
+{
+	static_assert(S1 > 0 && (S1 & (S1 - 1)) == 0 && S2 > 0 && (S2 & (S2 - 1)) == 0 && S3 > 0 && (S3 & (S3 - 1)) == 0 && S4 > 0 && (S4 & (S4 - 1)) == 0,
+		"     .");
+
+	int lower[4];
+	size_t length[4];
+	size_t count[4];
+	size_t stride[4];
+
+public:
+	/// <summary>
+	///     <see cref="bmatrix4_tiled_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	bmatrix4_tiled_layout(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='cell'>  .</param>
+	/// <param name='index'>    1-4.</param>
+	/// <returns>true,     ; false,   .</returns>
+	bool decode(size_t cell, int (&index)[4]) const;
+
+	/// <summary>
+	///             .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <exception cref="std::bad_alloc">     <c>size_t</c>.</exception>
+	static size_t getCapacity(const std::array<std::array<int, 2>, 4>& index);
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = TILED;
+
+	/// <summary>
+	///   ,     .
+	/// </summary>
+	static const size_t alignment = alignof(T) > CACHE_LINE_SIZE ? alignof(T) : CACHE_LINE_SIZE;
+
+	/// <summary>
+	///     1-4.
+	/// </summary>
+	static constexpr int tile[4] = { S1, S2, S3, S4 };
+
+	/// <summary>
+	///   ,  .
+	/// </summary>
+	static const size_t tileLength = (size_t)S1 * S2 * S3 * S4;
+
+private:
+	static constexpr int getShift(int length);
+};
+
+template<typename T>
+using bmatrix4_layout = bmatrix4_tiled_layout<T, 4, 4, 4, 16>;
+
+template<typename T>
+/// <summary>
+///      ,      ,   .
+/// </summary>
+class bmatrix4 : public matrix4_adapter<T, bmatrix4_layout>
+{
+public:
+	/// <summary>
+	///       <see cref="bmatrix4"/>    .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
+
+	/// <summary>
+	///      <see cref="bmatrix4"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
+	/// <summary>
+	///      <see cref="bmatrix4"/>    ,   ,    .
+	/// </summary>	
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='array'>,       .</param>
+	/// <param name="length">    <paramref name="array"/></param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// - -
+	///   <paramref name="array"/>  nullptr.
+	/// - -
+	///   <paramref name="length"/>  .
+	/// </exception>
+	bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
+
+	/// <summary>
+	///    <see cref="bmatrix4"/>,         .
+	/// </summary>
+	/// <remarks>    ,   <c>std::unique_ptr</c>  <c>std::vector</c>  .</remarks>
+	/// <param name='matrix'>,    .</param>
+	bmatrix4(matrix4<T, bmatrix4_layout>&& matrix);
+
+	template<typename Source>
+	/// <summary>
+	///      <see cref="bmatrix4"/>    ,           .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
+};
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline constexpr int bmatrix4_tiled_layout<T, S1, S2, S3, S4>::getShift(int length)
+{
+	return length > 1 ? 1 + getShift(length / 2) : 0;
+}
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline bmatrix4_tiled_layout<T, S1, S2, S3, S4>::bmatrix4_tiled_layout(const std::array<std::array<int, 2>, 4>& index, T *)
+{
+	for (int d = 0; d < 4; d++)
+	{
+		lower[d] = index[d][0];
+		length[d] = (size_t)((ptrdiff_t)index[d][1] - index[d][0]) + 1;
+		count[d] = (length[d] + tile[d] - 1) / tile[d];
+	}
+	stride[3] = tileLength;
+	for (int d = 2; d >= 0; d--)
+		stride[d] = stride[d + 1] * count[d + 1];
+}
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline T * bmatrix4_tiled_layout<T, S1, S2, S3, S4>::address(T * vector, int i1, int i2, int i3, int i4) const
+{
+	constexpr int s2 = getShift(S2), s3 = getShift(S3), s4 = getShift(S4);
+	MATRIX4_COUNT(counter.record(ADDITION, 11));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, 3));
+	size_t o1 = (size_t)(i1 - lower[0]), o2 = (size_t)(i2 - lower[1]), o3 = (size_t)(i3 - lower[2]), o4 = (size_t)(i4 - lower[3]);
+	size_t inner = (o1 & (S1 - 1)) << (s2 + s3 + s4) | (o2 & (S2 - 1)) << (s3 + s4) | (o3 & (S3 - 1)) << s4 | (o4 & (S4 - 1));
+	return vector + ((o1 >> getShift(S1)) * stride[0] + (o2 >> s2) * stride[1] + (o3 >> s3) * stride[2] + (o4 >> s4) * tileLength + inner);
+}
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline bool bmatrix4_tiled_layout<T, S1, S2, S3, S4>::decode(size_t cell, int (&index)[4]) const
+{
+	constexpr int s2 = getShift(S2), s3 = getShift(S3), s4 = getShift(S4);
+	size_t number = cell / tileLength, inner = cell % tileLength;
+	size_t offset[4];
+	offset[3] = (number % count[3]) << s4 | (inner & (S4 - 1));
+	number /= count[3];
+	offset[2] = (number % count[2]) << s3 | (inner >> s4 & (S3 - 1));
+	number /= count[2];
+	offset[1] = (number % count[1]) << s2 | (inner >> (s3 + s4) & (S2 - 1));
+	offset[0] = (number / count[1]) << getShift(S1) | inner >> (s2 + s3 + s4);
+	for (int d = 0; d < 4; d++)
+		index[d] = lower[d] + (int)offset[d];
+	return offset[0] < length[0] && offset[1] < length[1] && offset[2] < length[2] && offset[3] < length[3];
+}
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline size_t bmatrix4_tiled_layout<T, S1, S2, S3, S4>::getCapacity(const std::array<std::array<int, 2>, 4>& index)
+{
+	size_t capacity = tileLength;
+	for (int d = 0; d < 4; d++)
+	{
+		size_t tiles = ((size_t)((ptrdiff_t)index[d][1] - index[d][0]) + tile[d]) / tile[d];
+		if (tiles > (std::numeric_limits<size_t>::max)() / capacity)
+			throw std::bad_alloc();
+		capacity *= tiles;
+	}
+	return capacity;
+}
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline int bmatrix4_tiled_layout<T, S1, S2, S3, S4>::getAddCount()
+{
+	return 11;
+}
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline int bmatrix4_tiled_layout<T, S1, S2, S3, S4>::getMulCount()
+{
+	return 3;
+}
+
+template<typename T, int S1, int S2, int S3, int S4>
+inline int bmatrix4_tiled_layout<T, S1, S2, S3, S4>::getIndirectionCount()
+{
+	return 0;
+}
+
+template<typename T>
+inline bmatrix4<T>::bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4_adapter<T, bmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+{
+}
+
+template<typename T>
+inline bmatrix4<T>::bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix4_adapter<T, bmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
+{
+}
+
+template<typename T>
+inline bmatrix4<T>::bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4_adapter<T, bmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+{
+}
+
+template<typename T>
+inline bmatrix4<T>::bmatrix4(matrix4<T, bmatrix4_layout>&& matrix) : matrix4_adapter<T, bmatrix4_layout>::matrix4_adapter(std::move(matrix))
+{
+}
+
+template<typename T>
+template<typename Source>
+inline bmatrix4<T>::bmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix4_adapter<T, bmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
+{
+}
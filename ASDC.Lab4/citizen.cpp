@@ -2,35 +2,33 @@
 #include "citizen.h"
 
 
+/// <summary>
+///           .
+/// </summary>
+static std::string_view ReadName(FILE* file, string_arena& names)
+{
+	int count = 0;
+	fread(&count, sizeof(int), 1, file);
+	size_t length = count > 0 ? (size_t)count : 0;
+	char* text = names.allocate(length);
+	length = fread(text, sizeof(char), length, file);
+	text[length] = '\0';
+	return std::string_view(text, length);
+}
+
 CITIZEN::CITIZEN()
 {
-	first_name = new char('\0');
-	last_name = new char('\0');
 	birth = tm();
 }
 
-CITIZEN::CITIZEN(FILE * file)
+CITIZEN::CITIZEN(FILE * file, string_arena & names)
 {
 	fread(&pin, sizeof(int64_t), 1, file);
-	int count;
-	fread(&count, sizeof(int), 1, file);
-	first_name = new char[count + 1];
-	fread(first_name, sizeof(char), count, file);
-	first_name[count] = '\0';
-	fread(&count, sizeof(int), 1, file);
-	last_name = new char[count + 1];
-	fread(last_name, sizeof(char), count, file);
-	last_name[count] = '\0';
+	first_name = ReadName(file, names);
+	last_name = ReadName(file, names);
 	birth = tm();
 	fread(&birth.tm_mday, sizeof(int), 1, file);
 	fread(&birth.tm_mon, sizeof(int), 1, file);
 	fread(&birth.tm_year, sizeof(int), 1, file);
 	fread(&gender, sizeof(int), 1, file);
 }
-
-
-CITIZEN::~CITIZEN()
-{
-	//delete[] first_name;
-	//delete[] last_name;
-}
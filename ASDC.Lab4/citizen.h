@@ -1,17 +1,16 @@
 #pragma once
+#include "string_arena.h"
 
 class CITIZEN
 {
 public:
 
 	int64_t pin;
-	char* first_name;
-	char* last_name;
+	std::string_view first_name;
+	std::string_view last_name;
 	tm birth;
 	GENDER gender;
 
 	CITIZEN();
-	CITIZEN(FILE* file);
-	~CITIZEN();
+	CITIZEN(FILE* file, string_arena& names);
 };
-
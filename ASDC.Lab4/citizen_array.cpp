@@ -0,0 +1,20 @@
+#include "stdafx.h"
+#include "citizen_array.h"
+
+
+citizen_array::citizen_array(FILE * file) : items(nullptr), count(0)
+{
+	int length = 0;
+	fread(&length, sizeof(int), 1, file);
+	count = length > 0 ? (size_t)length : 0;
+	//   unique_ptr,    :     ,    
+	std::unique_ptr<CITIZEN[]> array(new CITIZEN[count]);
+	for (size_t i = 0; i < count; i++)
+		array[i] = CITIZEN(file, names);
+	items = array.release();
+}
+
+citizen_array::~citizen_array()
+{
+	delete[] items;
+}
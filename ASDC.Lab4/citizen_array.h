@@ -0,0 +1,53 @@
+#pragma once
+#include "citizen.h"
+
+/// <summary>
+///    <see cref="CITIZEN"/>,    ,      .
+/// </summary>
+/// <remarks>
+///       <see cref="string_arena"/> ,     ,
+///           .
+/// </remarks>
+class citizen_array
+{
+	string_arena names;
+	CITIZEN* items;
+	size_t count;
+
+public:
+	/// <summary>
+	///    <see cref="citizen_array"/>,        .
+	/// </summary>
+	/// <param name='file'>   ,     .</param>
+	/// <exception cref="std::bad_alloc">       .</exception>
+	citizen_array(FILE* file);
+
+	citizen_array(const citizen_array&) = delete;
+
+	citizen_array& operator=(const citizen_array&) = delete;
+
+	/// <summary>
+	///     ,  <see cref="citizen_array"/>.
+	/// </summary>
+	~citizen_array();
+
+	/// <summary>
+	///   .
+	/// </summary>
+	size_t getCount() const;
+
+	/// <summary>
+	///     .
+	/// </summary>
+	CITIZEN* getItems();
+};
+
+inline size_t citizen_array::getCount() const
+{
+	return count;
+}
+
+inline CITIZEN * citizen_array::getItems()
+{
+	return items;
+}
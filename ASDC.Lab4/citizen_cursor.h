@@ -0,0 +1,128 @@
+#pragma once
+#include "citizen_view.h"
+#include "resource.h"
+
+/// <summary>
+///      ,       citizens.
+/// </summary>
+/// <remarks>
+///    : PIN,      , ,      .
+///        ,     <see cref="moveNext"/>    .
+/// </remarks>
+class citizen_cursor
+{
+	const char* data;
+	size_t size;
+	size_t offset;
+	int count;
+	int index;
+	citizen_view current;
+
+public:
+	/// <summary>
+	///     <see cref="citizen_cursor"/>  ,   .
+	/// </summary>
+	/// <param name='data'>  .</param>
+	/// <param name='size'> ,    <paramref name="data"/>.</param>
+	/// <param name='count'> .</param>
+	citizen_cursor(const char* data, size_t size, int count);
+
+	/// <summary>
+	///     .
+	/// </summary>
+	/// <returns>true,      ; false,    .</returns>
+	/// <exception cref="std::runtime_error">     .</exception>
+	bool moveNext();
+
+	/// <summary>
+	///     ,    ,   .
+	/// </summary>
+	/// <remarks>   <see cref="getCurrent"/>  .</remarks>
+	/// <returns>true,      ; false,    .</returns>
+	/// <exception cref="std::runtime_error">     .</exception>
+	bool skip();
+
+	/// <summary>
+	///  ,    .
+	/// </summary>
+	/// <returns>    .</returns>
+	const citizen_view& getCurrent() const;
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <returns>    .</returns>
+	size_t getOffset() const;
+
+private:
+	int readInt();
+	std::string_view readString();
+};
+
+inline citizen_cursor::citizen_cursor(const char * data, size_t size, int count) : data(data), size(size), offset(0), count(count), index(0), current()
+{
+}
+
+inline bool citizen_cursor::moveNext()
+{
+	if (index >= count)
+		return false;
+	if (size - offset < sizeof(int64_t))
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	memcpy(&current.pin, data + offset, sizeof(int64_t));
+	offset += sizeof(int64_t);
+	current.first_name = readString();
+	current.last_name = readString();
+	current.day = readInt();
+	current.month = readInt();
+	current.year = readInt();
+	current.gender = (GENDER)readInt();
+	index++;
+	return true;
+}
+
+inline bool citizen_cursor::skip()
+{
+	if (index >= count)
+		return false;
+	if (size - offset < sizeof(int64_t))
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	offset += sizeof(int64_t);
+	readString();
+	readString();
+	if (size - offset < 4 * sizeof(int))
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	offset += 4 * sizeof(int);
+	index++;
+	return true;
+}
+
+inline const citizen_view & citizen_cursor::getCurrent() const
+{
+	return current;
+}
+
+inline size_t citizen_cursor::getOffset() const
+{
+	return offset;
+}
+
+inline int citizen_cursor::readInt()
+{
+	if (size - offset < sizeof(int))
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	int value;
+	memcpy(&value, data + offset, sizeof(int));
+	offset += sizeof(int);
+	return value;
+}
+
+inline std::string_view citizen_cursor::readString()
+{
+	int length = readInt();
+	if (length < 0 || size - offset < (size_t)length)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	std::string_view value(data + offset, (size_t)length);
+	offset += (size_t)length;
+	return value;
+}
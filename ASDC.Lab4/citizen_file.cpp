@@ -0,0 +1,92 @@
+#include "stdafx.h"
+#include "citizen_file.h"
+
+
+citizen_file::citizen_file(const char * path) : file(path), count(0)
+{
+	if (file.getSize() < sizeof(int))
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	memcpy(&count, file.getData(), sizeof(int));
+	if (count < 0)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+}
+
+int citizen_file::getCount() const
+{
+	return count;
+}
+
+citizen_cursor citizen_file::getCursor() const
+{
+	return citizen_cursor(file.getData() + sizeof(int), file.getSize() - sizeof(int), count);
+}
+
+size_t citizen_file::read(citizen_view * items, size_t length) const
+{
+	citizen_cursor cursor = getCursor();
+	size_t i = 0;
+	while (i < length && cursor.moveNext())
+		items[i++] = cursor.getCurrent();
+	return i;
+}
+
+size_t citizen_file::readParallel(citizen_view * items, size_t length, unsigned threadCount) const
+{
+	size_t total = length < (size_t)count ? length : (size_t)count;
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0)
+		threadCount = 1;
+	size_t chunk = (total + threadCount - 1) / threadCount;
+	if (chunk == 0)
+		return 0;
+	size_t chunkCount = (total + chunk - 1) / chunk;
+
+	//  :    ;      ,    
+	std::vector<size_t> offsets(chunkCount);
+	citizen_cursor cursor = getCursor();
+	for (size_t i = 0; i < (chunkCount - 1) * chunk; i++)
+	{
+		if (i % chunk == 0)
+			offsets[i / chunk] = cursor.getOffset();
+		cursor.skip();
+	}
+	offsets[chunkCount - 1] = cursor.getOffset();
+
+	//  :       
+	std::vector<std::exception_ptr> errors(chunkCount);
+	std::vector<std::thread> threads;
+	threads.reserve(chunkCount);
+	try
+	{
+		for (size_t c = 0; c < chunkCount; c++)
+			threads.emplace_back([this, items, total, chunk, c, &offsets, &errors]()
+			{
+				try
+				{
+					size_t first = c * chunk;
+					size_t last = first + chunk < total ? first + chunk : total;
+					size_t start = sizeof(int) + offsets[c];
+					citizen_cursor part(file.getData() + start, file.getSize() - start, (int)(last - first));
+					for (size_t i = first; part.moveNext(); i++)
+						items[i] = part.getCurrent();
+				}
+				catch (...)
+				{
+					errors[c] = std::current_exception();
+				}
+			});
+	}
+	catch (...)
+	{
+		for (std::thread& thread : threads)
+			thread.join();
+		throw;
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+	for (std::exception_ptr& error : errors)
+		if (error)
+			std::rethrow_exception(error);
+	return total;
+}
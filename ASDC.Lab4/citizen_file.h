@@ -0,0 +1,67 @@
+#pragma once
+#include "citizen_cursor.h"
+#include "file_mapping.h"
+
+/// <summary>
+///     ,      .
+/// </summary>
+/// <remarks>
+///     ,       <see cref="citizen_cursor"/>.
+///     ,         ,
+///   <see cref="citizen_view"/>     .
+/// </remarks>
+class citizen_file
+{
+	file_mapping file;
+	int count;
+
+public:
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <param name='path'>  .</param>
+	/// <exception cref="std::runtime_error">
+	///         .
+	/// --
+	///           .
+	/// </exception>
+	citizen_file(const char* path);
+
+	citizen_file(const citizen_file&) = delete;
+
+	citizen_file& operator=(const citizen_file&) = delete;
+
+	/// <summary>
+	///   ,    .
+	/// </summary>
+	int getCount() const;
+
+	/// <summary>
+	///  ,     .
+	/// </summary>
+	citizen_cursor getCursor() const;
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='items'>,    .</param>
+	/// <param name='length'> .</param>
+	/// <returns>  ,   <paramref name="length"/>  <see cref="getCount"/>.</returns>
+	/// <exception cref="std::runtime_error">    .</exception>
+	size_t read(citizen_view* items, size_t length) const;
+
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <remarks>
+	///     ,    ,      ,
+	///    ,     <paramref name="items"/>.
+	///     <see cref="read"/>.
+	/// </remarks>
+	/// <param name='items'>,    .</param>
+	/// <param name='length'> .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <returns>  ,   <paramref name="length"/>  <see cref="getCount"/>.</returns>
+	/// <exception cref="std::runtime_error">    .</exception>
+	size_t readParallel(citizen_view* items, size_t length, unsigned threadCount = 0) const;
+};
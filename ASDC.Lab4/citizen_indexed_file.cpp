@@ -0,0 +1,103 @@
+#include "stdafx.h"
+#include "citizen_indexed_file.h"
+
+
+citizen_indexed_file::citizen_indexed_file(const char * path) : file(path), count(0), records(nullptr), index(nullptr), strings(nullptr), stringsLength(0)
+{
+	uint64_t size = file.getSize();
+	if (size < sizeof(citizen_header))
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	const citizen_header* header = (const citizen_header*)file.getData();
+	if (header->magic != CITIZEN_INDEXED_MAGIC || header->version != CITIZEN_INDEXED_VERSION)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	uint64_t maxCount = (size - sizeof(citizen_header)) / (sizeof(citizen_record) + 2 * sizeof(uint64_t));
+	if (header->count > maxCount
+		|| header->index < sizeof(citizen_header) + header->count * sizeof(citizen_record)
+		|| header->index % sizeof(uint64_t) != 0
+		|| header->index > size
+		|| (size - header->index) / sizeof(uint64_t) < 2 * header->count + 1
+		|| header->strings < header->index + (2 * header->count + 1) * sizeof(uint64_t)
+		|| header->strings > size)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	count = (size_t)header->count;
+	records = (const citizen_record*)(file.getData() + sizeof(citizen_header));
+	index = (const uint64_t*)(file.getData() + header->index);
+	strings = file.getData() + header->strings;
+	stringsLength = size - header->strings;
+}
+
+citizen_view citizen_indexed_file::getView(size_t row) const
+{
+	if (row >= count)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_ROW);
+	const uint64_t* names = index + 2 * row;
+	if (names[0] > names[1] || names[1] > names[2] || names[2] > stringsLength)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+	const citizen_record& record = records[row];
+	citizen_view view;
+	view.pin = record.pin;
+	view.first_name = std::string_view(strings + names[0], (size_t)(names[1] - names[0]));
+	view.last_name = std::string_view(strings + names[1], (size_t)(names[2] - names[1]));
+	view.day = record.day;
+	view.month = record.month;
+	view.year = record.year;
+	view.gender = (GENDER)record.gender;
+	return view;
+}
+
+size_t citizen_indexed_file::read(citizen_view * items, size_t first, size_t length) const
+{
+	if (first >= count)
+		return 0;
+	size_t last = length < count - first ? first + length : count;
+	for (size_t row = first; row < last; row++)
+		items[row - first] = getView(row);
+	return last - first;
+}
+
+void citizen_indexed_file::convert(const citizen_file & source, const char * path)
+{
+	//     ,     
+	uint64_t count = (uint64_t)source.getCount();
+	std::vector<uint64_t> names;
+	names.reserve((size_t)(2 * count + 1));
+	uint64_t position = 0;
+	citizen_cursor cursor = source.getCursor();
+	while (cursor.moveNext())
+	{
+		names.push_back(position);
+		position += cursor.getCurrent().first_name.size();
+		names.push_back(position);
+		position += cursor.getCurrent().last_name.size();
+	}
+	names.push_back(position);
+
+	citizen_header header;
+	header.magic = CITIZEN_INDEXED_MAGIC;
+	header.version = CITIZEN_INDEXED_VERSION;
+	header.count = count;
+	header.index = sizeof(citizen_header) + count * sizeof(citizen_record);
+	header.strings = header.index + names.size() * sizeof(uint64_t);
+
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_WRITE);
+	bool written = fwrite(&header, sizeof(citizen_header), 1, file) == 1;
+	cursor = source.getCursor();
+	while (written && cursor.moveNext())
+	{
+		const citizen_view& item = cursor.getCurrent();
+		citizen_record record = { item.pin, item.day, item.month, item.year, (int32_t)item.gender };
+		written = fwrite(&record, sizeof(citizen_record), 1, file) == 1;
+	}
+	written = written && fwrite(names.data(), sizeof(uint64_t), names.size(), file) == names.size();
+	cursor = source.getCursor();
+	while (written && cursor.moveNext())
+	{
+		const citizen_view& item = cursor.getCurrent();
+		written = fwrite(item.first_name.data(), 1, item.first_name.size(), file) == item.first_name.size()
+			&& fwrite(item.last_name.data(), 1, item.last_name.size(), file) == item.last_name.size();
+	}
+	if (fclose(file) != 0 || !written)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_WRITE);
+}
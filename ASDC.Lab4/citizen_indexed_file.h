@@ -0,0 +1,83 @@
+#pragma once
+#include "citizen_record.h"
+#include "citizen_file.h"
+
+/// <summary>
+///          ,        .
+/// </summary>
+/// <remarks>
+///    <see cref="citizen_header"/>.    ,     ,
+///           .
+/// </remarks>
+class citizen_indexed_file
+{
+	file_mapping file;
+	size_t count;
+	const citizen_record* records;
+	const uint64_t* index;
+	const char* strings;
+	uint64_t stringsLength;
+
+public:
+	/// <summary>
+	///            .
+	/// </summary>
+	/// <param name='path'>  .</param>
+	/// <exception cref="std::runtime_error">
+	///         .
+	/// --
+	///           .
+	/// </exception>
+	citizen_indexed_file(const char* path);
+
+	/// <summary>
+	///     .
+	/// </summary>
+	size_t getCount() const;
+
+	/// <summary>
+	///      .
+	/// </summary>
+	const citizen_record* getRecords() const;
+
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <param name='row'> .</param>
+	/// <returns> ,      .</returns>
+	/// <exception cref="std::out_of_range">    <see cref="getCount"/>.</exception>
+	/// <exception cref="std::runtime_error">       .</exception>
+	citizen_view getView(size_t row) const;
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='items'>,    .</param>
+	/// <param name='first'>   .</param>
+	/// <param name='length'>  .</param>
+	/// <returns>  ,  <paramref name="length"/>,      .</returns>
+	/// <exception cref="std::runtime_error">       .</exception>
+	size_t read(citizen_view* items, size_t first, size_t length) const;
+
+	/// <summary>
+	///            .
+	/// </summary>
+	/// <param name='source'>      .</param>
+	/// <param name='path'>   .</param>
+	/// <exception cref="std::runtime_error">
+	///       .
+	/// --
+	///      .
+	/// </exception>
+	static void convert(const citizen_file& source, const char* path);
+};
+
+inline size_t citizen_indexed_file::getCount() const
+{
+	return count;
+}
+
+inline const citizen_record * citizen_indexed_file::getRecords() const
+{
+	return records;
+}
@@ -0,0 +1,261 @@
+#include "stdafx.h"
+#include "citizen_query.h"
+
+
+/// <summary>
+///    64  ,   ;       .
+/// </summary>
+static uint64_t GetGenderWord(const citizen_table& table, size_t row)
+{
+	const uint64_t* genders = table.getGenders();
+	size_t word = row / 64, shift = row % 64;
+	uint64_t bits = genders[word] >> shift;
+	if (shift != 0 && (word + 1) * 64 < table.getCount())
+		bits |= genders[word + 1] << (64 - shift);
+	return bits;
+}
+
+/// <summary>
+///       .
+/// </summary>
+static int GetLowestBit(uint64_t bits)
+{
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)bits))
+		return (int)index;
+	_BitScanForward(&index, (unsigned long)(bits >> 32));
+	return (int)index + 32;
+}
+
+static bool IsAnySet(const uint64_t* mask, size_t words)
+{
+	uint64_t any = 0;
+	for (size_t w = 0; w < words; w++)
+		any |= mask[w];
+	return any != 0;
+}
+
+static bool StartsWith(std::string_view name, std::string_view prefix)
+{
+	return name.size() >= prefix.size() && memcmp(name.data(), prefix.data(), prefix.size()) == 0;
+}
+
+citizen_query::citizen_query() : genders((1 << MALE) | (1 << FEMALE)), pinLow(INT64_MIN), pinHigh(INT64_MAX), birthLow(INT32_MIN), birthHigh(INT32_MAX), contradictory(false)
+{
+	for (int d = 0; d < 4; d++)
+	{
+		box[d][0] = (std::numeric_limits<int>::min)();
+		box[d][1] = (std::numeric_limits<int>::max)();
+	}
+}
+
+citizen_query & citizen_query::whereGender(GENDER gender)
+{
+	genders &= 1 << gender;
+	return *this;
+}
+
+citizen_query & citizen_query::wherePin(int64_t low, int64_t high)
+{
+	pinLow = low > pinLow ? low : pinLow;
+	pinHigh = high < pinHigh ? high : pinHigh;
+	return *this;
+}
+
+citizen_query & citizen_query::whereBirth(int32_t low, int32_t high)
+{
+	birthLow = low > birthLow ? low : birthLow;
+	birthHigh = high < birthHigh ? high : birthHigh;
+	return *this;
+}
+
+citizen_query & citizen_query::whereBirthYear(int from, int to)
+{
+	//      9   ,     
+	return whereBirth(citizen_table::packBirth(0, 0, from), citizen_table::packBirth(31, 15, to));
+}
+
+citizen_query & citizen_query::whereFirstName(std::string_view prefix)
+{
+	narrowPrefix(firstName, prefix, contradictory);
+	return *this;
+}
+
+citizen_query & citizen_query::whereLastName(std::string_view prefix)
+{
+	narrowPrefix(lastName, prefix, contradictory);
+	return *this;
+}
+
+citizen_query & citizen_query::within(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h)
+{
+	if (i1l > i1h)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_I1);
+	if (i2l > i2h)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_I2);
+	if (i3l > i3h)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_I3);
+	if (i4l > i4h)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_I4);
+	int index[4][2] = { { i1l, i1h }, { i2l, i2h }, { i3l, i3h }, { i4l, i4h } };
+	for (int d = 0; d < 4; d++)
+	{
+		box[d][0] = index[d][0] > box[d][0] ? index[d][0] : box[d][0];
+		box[d][1] = index[d][1] < box[d][1] ? index[d][1] : box[d][1];
+	}
+	return *this;
+}
+
+citizen_selection citizen_query::execute(const citizen_table & table, const int (&bounds)[4][2], unsigned threadCount) const
+{
+	static const char* const messages[4] = { MESSAGE_INVALID_ARGUMENT_I1, MESSAGE_INVALID_ARGUMENT_I2, MESSAGE_INVALID_ARGUMENT_I3, MESSAGE_INVALID_ARGUMENT_I4 };
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	size_t extent[4], stride[4], count = 1;
+	for (int d = 0; d < 4; d++)
+	{
+		if (bounds[d][0] > bounds[d][1])
+			throw std::invalid_argument(messages[d]);
+		extent[d] = (size_t)((int64_t)bounds[d][1] - bounds[d][0] + 1);
+		count *= extent[d];
+	}
+	if (count != table.getCount())
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_TABLE);
+	for (int d = 3; d >= 0; d--)
+		stride[d] = d == 3 ? 1 : stride[d + 1] * extent[d + 1];
+
+	//        
+	size_t lower[4], length[4];
+	bool empty = isEmpty();
+	for (int d = 0; d < 4; d++)
+	{
+		int low = box[d][0] > bounds[d][0] ? box[d][0] : bounds[d][0];
+		int high = box[d][1] < bounds[d][1] ? box[d][1] : bounds[d][1];
+		empty = empty || low > high;
+		lower[d] = empty ? 0 : (size_t)((int64_t)low - bounds[d][0]);
+		length[d] = empty ? 0 : (size_t)((int64_t)high - low + 1);
+	}
+
+	citizen_selection selection;
+	selection.scanned = 0;
+	if (!empty)
+	{
+		//    ,   ,   ,  ;
+		//    ,       
+		int split = 3;
+		size_t run = length[3];
+		while (split > 0 && length[split] == extent[split])
+		{
+			split--;
+			run *= length[split];
+		}
+		size_t runs = 1;
+		for (int d = 0; d < split; d++)
+			runs *= length[d];
+		selection.scanned = runs * run;
+
+		size_t taskCount = (selection.scanned + TASK_ROWS - 1) / TASK_ROWS;
+		std::vector<std::vector<size_t>> rows(taskCount);
+		std::vector<std::vector<std::array<int, 4>>> indices(taskCount);
+		if (selection.scanned < matrix4_parallel::PARALLEL_THRESHOLD)
+			threadCount = 1;
+		matrix4_parallel::run(taskCount, threadCount, [&](size_t task)
+		{
+			size_t position = task * TASK_ROWS, end = position + TASK_ROWS < selection.scanned ? position + TASK_ROWS : selection.scanned;
+			while (position < end)
+			{
+				size_t k = position / run, offset = position % run;
+				size_t first = lower[split] * stride[split] + offset;
+				for (int d = split - 1; d >= 0; d--)
+				{
+					first += (lower[d] + k % length[d]) * stride[d];
+					k /= length[d];
+				}
+				size_t piece = run - offset < end - position ? run - offset : end - position;
+				scan(table, first, piece, rows[task]);
+				position += piece;
+			}
+
+			indices[task].resize(rows[task].size());
+			for (size_t i = 0; i < rows[task].size(); i++)
+			{
+				size_t row = rows[task][i];
+				for (int d = 3; d >= 0; d--)
+				{
+					indices[task][i][d] = bounds[d][0] + (int)(row % extent[d]);
+					row /= extent[d];
+				}
+			}
+		});
+
+		size_t found = 0;
+		for (size_t t = 0; t < taskCount; t++)
+			found += rows[t].size();
+		selection.rows.reserve(found);
+		selection.indices.reserve(found);
+		for (size_t t = 0; t < taskCount; t++)
+		{
+			selection.rows.insert(selection.rows.end(), rows[t].begin(), rows[t].end());
+			selection.indices.insert(selection.indices.end(), indices[t].begin(), indices[t].end());
+		}
+	}
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	selection.seconds = std::chrono::duration<double>(end - start).count();
+	return selection;
+}
+
+void citizen_query::scan(const citizen_table & table, size_t first, size_t count, std::vector<size_t>& rows) const
+{
+	uint64_t mask[BLOCK_ROWS / 64];
+	bool byGender = genders != ((1 << MALE) | (1 << FEMALE));
+	bool byBirth = birthLow != INT32_MIN || birthHigh != INT32_MAX;
+	bool byPin = pinLow != INT64_MIN || pinHigh != INT64_MAX;
+	for (size_t block = 0; block < count; block += BLOCK_ROWS)
+	{
+		size_t row = first + block;
+		size_t length = count - block < BLOCK_ROWS ? count - block : BLOCK_ROWS;
+		size_t words = (length + 63) / 64;
+		for (size_t w = 0; w < words; w++)
+			mask[w] = ~(uint64_t)0;
+		if (length % 64 != 0)
+			mask[words - 1] = ((uint64_t)1 << (length % 64)) - 1;
+
+		//     ;      
+		if (byGender)
+			for (size_t w = 0; w < words; w++)
+			{
+				uint64_t female = GetGenderWord(table, row + 64 * w);
+				mask[w] &= genders == (1 << FEMALE) ? female : ~female;
+			}
+		if (byBirth && IsAnySet(mask, words))
+			simd_kernels<int32_t>::between(birthLow, birthHigh, table.getBirths() + row, mask, length);
+		if (byPin && IsAnySet(mask, words))
+			simd_kernels<int64_t>::between(pinLow, pinHigh, table.getPins() + row, mask, length);
+
+		for (size_t w = 0; w < words; w++)
+			for (uint64_t bits = mask[w]; bits != 0; bits &= bits - 1)
+			{
+				size_t current = row + 64 * w + GetLowestBit(bits);
+				if (!firstName.empty() && !StartsWith(table.getFirstName(current), firstName))
+					continue;
+				if (!lastName.empty() && !StartsWith(table.getLastName(current), lastName))
+					continue;
+				rows.push_back(current);
+			}
+	}
+}
+
+bool citizen_query::isEmpty() const
+{
+	return genders == 0 || pinLow > pinHigh || birthLow > birthHigh || contradictory;
+}
+
+void citizen_query::narrowPrefix(std::string & prefix, std::string_view value, bool & contradictory)
+{
+	//         ,     
+	if (value.size() >= prefix.size() && StartsWith(value, prefix))
+		prefix.assign(value.data(), value.size());
+	else if (!StartsWith(prefix, value))
+		contradictory = true;
+}
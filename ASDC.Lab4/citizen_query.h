@@ -0,0 +1,153 @@
+#pragma once
+#include "citizen_table.h"
+
+/// <summary>
+///    <see cref="citizen_query"/>:  ,  ,      .
+/// </summary>
+struct citizen_selection
+{
+	/// <summary>
+	///      .
+	/// </summary>
+	std::vector<size_t> rows;
+
+	/// <summary>
+	///  <c>i1</c>, <c>i2</c>, <c>i3</c>, <c>i4</c>       <see cref="rows"/>.
+	/// </summary>
+	std::vector<std::array<int, 4>> indices;
+
+	/// <summary>
+	///  ,         .
+	/// </summary>
+	size_t scanned;
+
+	/// <summary>
+	///     .
+	/// </summary>
+	double seconds;
+
+	/// <summary>
+	///      .
+	/// </summary>
+	double getRowsPerSecond() const;
+};
+
+/// <summary>
+///     <see cref="citizen_table"/>:          .
+/// </summary>
+/// <remarks>
+///           <c>ROW_MAJOR</c>,   ,     
+///   .      : ,    ,   
+///   ,     <c>[a..b] x * x * x</c>   .
+///     <see cref="BLOCK_ROWS"/> .     ,     
+///   :      ,    PIN   <see cref="simd_kernels::between"/>,
+///     ,   .       ,     .
+///        .        ,
+///      ,      .
+/// </remarks>
+class citizen_query
+{
+	unsigned genders;
+	int64_t pinLow;
+	int64_t pinHigh;
+	int32_t birthLow;
+	int32_t birthHigh;
+	std::string firstName;
+	std::string lastName;
+	bool contradictory;
+	int box[4][2];
+
+public:
+	/// <summary>
+	///    <see cref="citizen_query"/>  ,     .
+	/// </summary>
+	citizen_query();
+
+	/// <summary>
+	///     .
+	/// </summary>
+	/// <param name='gender'> .</param>
+	/// <returns>   .</returns>
+	citizen_query& whereGender(GENDER gender);
+
+	/// <summary>
+	///  , PIN     .
+	/// </summary>
+	/// <param name='low'> PIN.</param>
+	/// <param name='high'> PIN.</param>
+	/// <returns>   .</returns>
+	citizen_query& wherePin(int64_t low, int64_t high);
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <param name='low'> ,  <see cref="citizen_table::packBirth"/>.</param>
+	/// <param name='high'> ,  <see cref="citizen_table::packBirth"/>.</param>
+	/// <returns>   .</returns>
+	citizen_query& whereBirth(int32_t low, int32_t high);
+
+	/// <summary>
+	///   ,     .
+	/// </summary>
+	/// <param name='from'>  .</param>
+	/// <param name='to'>  .</param>
+	/// <returns>   .</returns>
+	citizen_query& whereBirthYear(int from, int to);
+
+	/// <summary>
+	///  ,       .
+	/// </summary>
+	/// <param name='prefix'> .</param>
+	/// <returns>   .</returns>
+	citizen_query& whereFirstName(std::string_view prefix);
+
+	/// <summary>
+	///  ,       .
+	/// </summary>
+	/// <param name='prefix'> .</param>
+	/// <returns>   .</returns>
+	citizen_query& whereLastName(std::string_view prefix);
+
+	/// <summary>
+	///    ,      ;       .
+	/// </summary>
+	/// <returns>   .</returns>
+	/// <exception cref="std::invalid_argument">  -   .</exception>
+	citizen_query& within(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
+
+	/// <summary>
+	///    ,        .
+	/// </summary>
+	/// <param name='table'>   .</param>
+	/// <param name='bounds'>        .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <returns> ,      .</returns>
+	/// <exception cref="std::invalid_argument">
+	///     .
+	/// --
+	///         .
+	/// </exception>
+	citizen_selection execute(const citizen_table& table, const int (&bounds)[4][2], unsigned threadCount = 0) const;
+
+private:
+	/// <summary>
+	///   ,      ;       .
+	/// </summary>
+	static const size_t BLOCK_ROWS = 4096;
+
+	/// <summary>
+	///   ,   .
+	/// </summary>
+	static const size_t TASK_ROWS = 1 << 16;
+
+	void scan(const citizen_table& table, size_t first, size_t count, std::vector<size_t>& rows) const;
+
+	bool isEmpty() const;
+
+	static void narrowPrefix(std::string& prefix, std::string_view value, bool& contradictory);
+};
+
+inline double citizen_selection::getRowsPerSecond() const
+{
+	return seconds > 0 ? scanned / seconds : 0;
+}
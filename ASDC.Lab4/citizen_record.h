@@ -0,0 +1,41 @@
+#pragma once
+
+/// <summary>
+///        ("CTZN").
+/// </summary>
+#define CITIZEN_INDEXED_MAGIC 0x4E5A5443
+
+/// <summary>
+///        .
+/// </summary>
+#define CITIZEN_INDEXED_VERSION 2
+
+/// <summary>
+///        .
+/// </summary>
+/// <remarks>
+///    <see cref="count"/>  <see cref="citizen_record"/>,    <c>2 * count + 1</c>
+/// 64-    .   <c>i</c>       <c>index[2 * i]</c>
+///  <c>index[2 * i + 1]</c>,    <c>index[2 * i + 1]</c>  <c>index[2 * i + 2]</c>.
+///          ,      .
+/// </remarks>
+struct citizen_header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t count;
+	uint64_t index;
+	uint64_t strings;
+};
+
+/// <summary>
+///          .
+/// </summary>
+struct citizen_record
+{
+	int64_t pin;
+	int32_t day;
+	int32_t month;
+	int32_t year;
+	int32_t gender;
+};
@@ -0,0 +1,84 @@
+#include "stdafx.h"
+#include "citizen_table.h"
+
+
+citizen_table::citizen_table(const citizen_file & file) : count(0), pins(nullptr), births(nullptr), genders(nullptr), names(nullptr), pool(nullptr)
+{
+	//      ,   
+	size_t poolLength = 0;
+	citizen_cursor cursor = file.getCursor();
+	while (cursor.moveNext())
+	{
+		poolLength += cursor.getCurrent().first_name.size() + cursor.getCurrent().last_name.size();
+		count++;
+	}
+
+	try
+	{
+		pins = new int64_t[count];
+		births = new int32_t[count];
+		genders = new uint64_t[(count + 63) / 64]();
+		names = new size_t[2 * count + 1];
+		pool = new char[poolLength > 0 ? poolLength : 1];
+	}
+	catch (...)
+	{
+		release();
+		throw;
+	}
+
+	size_t position = 0;
+	cursor = file.getCursor();
+	for (size_t row = 0; cursor.moveNext(); row++)
+	{
+		const citizen_view& item = cursor.getCurrent();
+		if (item.day < 0 || item.day > 31 || item.month < 0 || item.month > 15)
+		{
+			release();
+			throw std::runtime_error(MESSAGE_RUNTIME_ERROR_FORMAT);
+		}
+		pins[row] = item.pin;
+		births[row] = packBirth(item.day, item.month, item.year);
+		if (item.gender == FEMALE)
+			genders[row / 64] |= (uint64_t)1 << (row % 64);
+		names[2 * row] = position;
+		memcpy(pool + position, item.first_name.data(), item.first_name.size());
+		position += item.first_name.size();
+		names[2 * row + 1] = position;
+		memcpy(pool + position, item.last_name.data(), item.last_name.size());
+		position += item.last_name.size();
+	}
+	names[2 * count] = position;
+}
+
+citizen_table::~citizen_table()
+{
+	release();
+}
+
+citizen_view citizen_table::getView(size_t row) const
+{
+	citizen_view view;
+	view.pin = pins[row];
+	view.first_name = getFirstName(row);
+	view.last_name = getLastName(row);
+	view.day = getDay(row);
+	view.month = getMonth(row);
+	view.year = getYear(row);
+	view.gender = getGender(row);
+	return view;
+}
+
+void citizen_table::release()
+{
+	delete[] pins;
+	delete[] births;
+	delete[] genders;
+	delete[] names;
+	delete[] pool;
+	pins = nullptr;
+	births = nullptr;
+	genders = nullptr;
+	names = nullptr;
+	pool = nullptr;
+}
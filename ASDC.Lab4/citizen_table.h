@@ -0,0 +1,177 @@
+#pragma once
+#include "citizen_file.h"
+
+/// <summary>
+///     ,        .
+/// </summary>
+/// <remarks>
+/// PIN   <c>int64_t</c>,      32-  (<c> * 512 +  * 32 + </c>,
+///       ),     (  
+/// <see cref="FEMALE"/>),             .
+///       .            
+/// <see cref="matrix4::getOffset"/> ,     .
+/// </remarks>
+class citizen_table
+{
+	size_t count;
+	int64_t* pins;
+	int32_t* births;
+	uint64_t* genders;
+	size_t* names;
+	char* pool;
+
+public:
+	/// <summary>
+	///    <see cref="citizen_table"/>,    .
+	/// </summary>
+	/// <param name='file'>      .</param>
+	/// <exception cref="std::runtime_error">    ,          .</exception>
+	/// <exception cref="std::bad_alloc">      .</exception>
+	citizen_table(const citizen_file& file);
+
+	citizen_table(const citizen_table&) = delete;
+
+	citizen_table& operator=(const citizen_table&) = delete;
+
+	/// <summary>
+	///   ,  <see cref="citizen_table"/>.
+	/// </summary>
+	~citizen_table();
+
+	/// <summary>
+	///    .
+	/// </summary>
+	size_t getCount() const;
+
+	/// <summary>
+	///   PIN.
+	/// </summary>
+	const int64_t* getPins() const;
+
+	/// <summary>
+	///     .
+	/// </summary>
+	const int32_t* getBirths() const;
+
+	/// <summary>
+	///    ,  64   .
+	/// </summary>
+	const uint64_t* getGenders() const;
+
+	/// <summary>
+	///  PIN    .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	int64_t getPin(size_t row) const;
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	int getDay(size_t row) const;
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	int getMonth(size_t row) const;
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	int getYear(size_t row) const;
+
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	GENDER getGender(size_t row) const;
+
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	std::string_view getFirstName(size_t row) const;
+
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	std::string_view getLastName(size_t row) const;
+
+	/// <summary>
+	///        ;      .
+	/// </summary>
+	/// <param name='row'>    .</param>
+	citizen_view getView(size_t row) const;
+
+	/// <summary>
+	///       <see cref="getBirths"/>.
+	/// </summary>
+	/// <returns> .</returns>
+	static int32_t packBirth(int day, int month, int year);
+
+private:
+	void release();
+};
+
+inline size_t citizen_table::getCount() const
+{
+	return count;
+}
+
+inline const int64_t * citizen_table::getPins() const
+{
+	return pins;
+}
+
+inline const int32_t * citizen_table::getBirths() const
+{
+	return births;
+}
+
+inline const uint64_t * citizen_table::getGenders() const
+{
+	return genders;
+}
+
+inline int64_t citizen_table::getPin(size_t row) const
+{
+	return pins[row];
+}
+
+inline int citizen_table::getDay(size_t row) const
+{
+	return births[row] & 31;
+}
+
+inline int citizen_table::getMonth(size_t row) const
+{
+	return (births[row] >> 5) & 15;
+}
+
+inline int citizen_table::getYear(size_t row) const
+{
+	return births[row] >> 9;
+}
+
+inline GENDER citizen_table::getGender(size_t row) const
+{
+	return (genders[row / 64] >> (row % 64)) & 1 ? FEMALE : MALE;
+}
+
+inline std::string_view citizen_table::getFirstName(size_t row) const
+{
+	return std::string_view(pool + names[2 * row], names[2 * row + 1] - names[2 * row]);
+}
+
+inline std::string_view citizen_table::getLastName(size_t row) const
+{
+	return std::string_view(pool + names[2 * row + 1], names[2 * row + 2] - names[2 * row + 1]);
+}
+
+inline int32_t citizen_table::packBirth(int day, int month, int year)
+{
+	return year * 512 + month * 32 + day;
+}
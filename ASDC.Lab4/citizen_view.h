@@ -0,0 +1,19 @@
+#pragma once
+
+/// <summary>
+///    ,          .
+/// </summary>
+/// <remarks>
+///        ;  ,  
+/// <see cref="citizen_file"/>,    .
+/// </remarks>
+struct citizen_view
+{
+	int64_t pin;
+	std::string_view first_name;
+	std::string_view last_name;
+	int day;
+	int month;
+	int year;
+	GENDER gender;
+};
@@ -1,12 +1,71 @@
 #pragma once
-#include "matrix4.h"
-#include "resource.h"
+#include "matrix4_adapter.h"
+
+template<typename T>
+/// <summary>
+///      ,      .
+/// </summary>
+class cmatrix4_layout : public counted_layout
+{
+	int lower[4];
+	ptrdiff_t length[4];
+
+public:
+	/// <summary>
+	///     <see cref="cmatrix4_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	cmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = COLUMN_MAJOR;
+
+	/// <summary>
+	///   ,            ;    .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+
+private:
+	ptrdiff_t getDimension(int dimension) const;
+};
 
 template<typename T>
 /// <summary>
 ///      ,   ,   .
 /// </summary>
-class cmatrix4 : public matrix4<T>
+class cmatrix4 : public matrix4_adapter<T, cmatrix4_layout>
 {
 public:
 	/// <summary>
@@ -31,6 +90,29 @@ public:
 	/// </exception>
 	cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
 
+	/// <summary>
+	///      <see cref="cmatrix4"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
 	/// <summary>
 	///      <see cref="cmatrix4"/>    ,   ,    .
 	/// </summary>	
@@ -60,76 +142,108 @@ public:
 	cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
 
 	/// <summary>
-	///       .
+	///    <see cref="cmatrix4"/>,         .
 	/// </summary>
-	/// <param name='i1'>  ,     .</param>
-	/// <param name='i2'>  ,     .</param>
-	/// <param name='i3'>  ,     .</param>
-	/// <param name='i4'>  ,     .</param>
-	/// <returns>  ,    .</returns>
-	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
-	virtual T& at(int i1, int i2, int i3, int i4);
+	/// <remarks>    ,   <c>std::unique_ptr</c>  <c>std::vector</c>  .</remarks>
+	/// <param name='matrix'>,    .</param>
+	cmatrix4(matrix4<T, cmatrix4_layout>&& matrix);
 
+	template<typename Source>
 	/// <summary>
-	///  ,        .
+	///      <see cref="cmatrix4"/>    ,           .
 	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	int getAddCount();
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
+};
 
-	/// <summary>
-	///  ,        .
-	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	int getMulCount();
+template<typename T>
+inline cmatrix4_layout<T>::cmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T *)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		lower[i] = index[i][0];
+		length[i] = (ptrdiff_t)index[i][1] - index[i][0] + 1;
+	}
+}
 
-private:
-	int getDimension(int dimension);
-};
+template<typename T>
+inline ptrdiff_t cmatrix4_layout<T>::getDimension(int dimension) const
+{
+	ptrdiff_t _dimension[4];
+	_dimension[0] = 1;
+	for (int i = 1; i < dimension; i++)
+	{
+		_dimension[i] = _dimension[i - 1] * length[i - 1];
+		MATRIX4_COUNT(counter.record(MULTIPLICATION, 1));
+	}
+	return _dimension[dimension - 1];
+}
 
 template<typename T>
-inline cmatrix4<T>::cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+inline T * cmatrix4_layout<T>::address(T * vector, int i1, int i2, int i3, int i4) const
 {
+	MATRIX4_COUNT(counter.record(ADDITION, 7));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, 4));
+	return vector + (i1 - lower[0]) * getDimension(1) + (i2 - lower[1]) * getDimension(2) + (i3 - lower[2]) * getDimension(3) + (i4 - lower[3]) * getDimension(4);
 }
 
 template<typename T>
-inline cmatrix4<T>::cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+inline int cmatrix4_layout<T>::getAddCount()
 {
+	return 7;
 }
 
 template<typename T>
-inline T & cmatrix4<T>::at(int i1, int i2, int i3, int i4)
+inline int cmatrix4_layout<T>::getMulCount()
 {
-	if (i1 < matrix4<T>::getLowerBound(1) || i1 > matrix4<T>::getUpperBound(1))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I1);
-	if (i2 < matrix4<T>::getLowerBound(2) || i2 > matrix4<T>::getUpperBound(2))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I2);
-	if (i3 < matrix4<T>::getLowerBound(3) || i3 > matrix4<T>::getUpperBound(3))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I3);
-	if (i4 < matrix4<T>::getLowerBound(4) || i4 > matrix4<T>::getUpperBound(4))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I4);
-
-	return matrix4<T>::_vector[(i1 - this->getLowerBound(1)) * getDimension(1) + (i2 - this->getLowerBound(2)) * getDimension(2) + (i3 - this->getLowerBound(3)) * getDimension(3) + (i4 - this->getLowerBound(4)) * getDimension(4)];
+	return 10;
 }
 
 template<typename T>
-inline int cmatrix4<T>::getDimension(int dimension)
+inline int cmatrix4_layout<T>::getIndirectionCount()
 {
-	int _dimension[4];
-	_dimension[0] = 1;
-	for (int i = 1; i < dimension; i++)
-		_dimension[i] = _dimension[i - 1] * matrix4<T>::getLength(i);
-	return _dimension[dimension - 1];
+	return 0;
 }
 
+template<typename T>
+inline cmatrix4<T>::cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4_adapter<T, cmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+{
+}
 
 template<typename T>
-inline int cmatrix4<T>::getAddCount()
+inline cmatrix4<T>::cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix4_adapter<T, cmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
 {
-	return 7;
 }
 
 template<typename T>
-inline int cmatrix4<T>::getMulCount()
+inline cmatrix4<T>::cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4_adapter<T, cmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+{
+}
+
+template<typename T>
+inline cmatrix4<T>::cmatrix4(matrix4<T, cmatrix4_layout>&& matrix) : matrix4_adapter<T, cmatrix4_layout>::matrix4_adapter(std::move(matrix))
+{
+}
+
+template<typename T>
+template<typename Source>
+inline cmatrix4<T>::cmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix4_adapter<T, cmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
 {
-	return 10;
 }
@@ -1,16 +1,86 @@
 #pragma once
-#include "matrix4.h"
-#include "resource.h"
+#include "matrix4_adapter.h"
+
+template<typename T, size_t Alignment>
+/// <summary>
+///      ,   ,           <typeparamref name="Alignment"/> .
+/// </summary>
+/// <remarks>
+///        ,  <typeparamref name="Alignment"/> ,   
+///           ;       .
+///  <c>Alignment</c>,  <c>alignof(T)</c>,    .
+/// </remarks>
+class cmatrix4m_aligned_layout : public counted_layout
+{
+	ptrdiff_t _dimension[4];
+	ptrdiff_t _dimensionSum;
+
+public:
+	/// <summary>
+	///     <see cref="cmatrix4m_aligned_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	cmatrix4m_aligned_layout(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = COLUMN_MAJOR;
+
+	/// <summary>
+	///   ,            .
+	/// </summary>
+	static const size_t alignment = Alignment;
+};
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrix4m_aligned_layout"/>   .
+/// </summary>
+using cmatrix4m_layout = cmatrix4m_aligned_layout<T, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrix4m_aligned_layout"/>  ,      (64 ).
+/// </summary>
+using cmatrix4m_layout64 = cmatrix4m_aligned_layout<T, CACHE_LINE_SIZE>;
 
 template<typename T>
 /// <summary>
 ///      ,   ,   ,   .
 /// </summary>
-class cmatrix4m : public matrix4<T>
+class cmatrix4m : public matrix4_adapter<T, cmatrix4m_layout>
 {
-	int* _dimension;
-	int _dimensionSum;
-
 public:
 	/// <summary>
 	///       <see cref="cmatrix4m"/>    .
@@ -34,6 +104,29 @@ public:
 	/// </exception>
 	cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
 
+	/// <summary>
+	///      <see cref="cmatrix4m"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
 	/// <summary>
 	///      <see cref="cmatrix4m"/>    ,   ,    .
 	/// </summary>	
@@ -63,91 +156,95 @@ public:
 	cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
 
 	/// <summary>
-	///   ,  <see cref="cmatrix4m"/>.
-	/// </summary>
-	~cmatrix4m();
-	
-	/// <summary>
-	///       .
-	/// </summary>
-	/// <param name='i1'>  ,     .</param>
-	/// <param name='i2'>  ,     .</param>
-	/// <param name='i3'>  ,     .</param>
-	/// <param name='i4'>  ,     .</param>
-	/// <returns>  ,    .</returns>
-	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
-	T& at(int i1, int i2, int i3, int i4);
-
-	/// <summary>
-	///  ,        .
+	///    <see cref="cmatrix4m"/>,         .
 	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	virtual int getAddCount();
+	/// <remarks>    ,   <c>std::unique_ptr</c>  <c>std::vector</c>  .</remarks>
+	/// <param name='matrix'>,    .</param>
+	cmatrix4m(matrix4<T, cmatrix4m_layout>&& matrix);
 
+	template<typename Source>
 	/// <summary>
-	///  ,        .
+	///      <see cref="cmatrix4m"/>    ,           .
 	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	virtual int getMulCount();
-
-private:
-	int getDimension(int dimension);
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
 };
 
-template<typename T>
-inline cmatrix4m<T>::cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+template<typename T, size_t Alignment>
+inline cmatrix4m_aligned_layout<T, Alignment>::cmatrix4m_aligned_layout(const std::array<std::array<int, 2>, 4>& index, T *)
 {
-	_dimension = new int[4];
 	_dimension[0] = 1;
-	for (int i = 1; i <= 3; i++)
-		_dimension[i] = _dimension[i - 1] * matrix4<T>::getLength(i);
-	_dimensionSum = _dimension[0] * this->getLowerBound(1) + _dimension[1] * this->getLowerBound(2) + _dimension[2] * this->getLowerBound(3) + _dimension[3] * this->getLowerBound(4);
+	_dimension[1] = (ptrdiff_t)matrix4_storage<T>::getPitch((size_t)index[0][1] - index[0][0] + 1, Alignment);
+	for (int i = 2; i <= 3; i++)
+		_dimension[i] = _dimension[i - 1] * ((ptrdiff_t)index[i - 1][1] - index[i - 1][0] + 1);
+	_dimensionSum = _dimension[0] * index[0][0] + _dimension[1] * index[1][0] + _dimension[2] * index[2][0] + _dimension[3] * index[3][0];
 }
 
-template<typename T>
-inline cmatrix4m<T>::cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+template<typename T, size_t Alignment>
+inline T * cmatrix4m_aligned_layout<T, Alignment>::address(T * vector, int i1, int i2, int i3, int i4) const
 {
-	_dimension = new int[4];
-	_dimension[0] = 1;
-	for (int i = 1; i <= 3; i++) 
-		_dimension[i] = _dimension[i - 1] * matrix4<T>::getLength(i);
-	_dimensionSum = _dimension[0] * this->getLowerBound(1) + _dimension[1] * this->getLowerBound(2) + _dimension[2] * this->getLowerBound(3) + _dimension[3] * this->getLowerBound(4);
+	MATRIX4_COUNT(counter.record(ADDITION, 4));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, 4));
+	return vector + (i1 * _dimension[0] + i2 * _dimension[1] + i3 * _dimension[2] + i4 * _dimension[3] - _dimensionSum);
+}
+
+template<typename T, size_t Alignment>
+inline int cmatrix4m_aligned_layout<T, Alignment>::getAddCount()
+{
+	return 4;
+}
+
+template<typename T, size_t Alignment>
+inline int cmatrix4m_aligned_layout<T, Alignment>::getMulCount()
+{
+	return 4;
+}
+
+template<typename T, size_t Alignment>
+inline int cmatrix4m_aligned_layout<T, Alignment>::getIndirectionCount()
+{
+	return 0;
 }
 
 template<typename T>
-inline cmatrix4m<T>::~cmatrix4m()
+inline cmatrix4m<T>::cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4_adapter<T, cmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
 {
-	delete[] _dimension;
 }
 
 template<typename T>
-inline int cmatrix4m<T>::getAddCount()
+inline cmatrix4m<T>::cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix4_adapter<T, cmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
 {
-	return 4;
 }
 
 template<typename T>
-inline int cmatrix4m<T>::getMulCount()
+inline cmatrix4m<T>::cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4_adapter<T, cmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
 {
-	return 4;
 }
 
 template<typename T>
-inline int cmatrix4m<T>::getDimension(int dimension)
+inline cmatrix4m<T>::cmatrix4m(matrix4<T, cmatrix4m_layout>&& matrix) : matrix4_adapter<T, cmatrix4m_layout>::matrix4_adapter(std::move(matrix))
 {
-	return _dimension[dimension - 1];
 }
 
 template<typename T>
-inline T & cmatrix4m<T>::at(int i1, int i2, int i3, int i4)
+template<typename Source>
+inline cmatrix4m<T>::cmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix4_adapter<T, cmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
 {
-	if (i1 < matrix4<T>::getLowerBound(1) || i1 > matrix4<T>::getUpperBound(1))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I1);
-	if (i2 < matrix4<T>::getLowerBound(2) || i2 > matrix4<T>::getUpperBound(2))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I2);
-	if (i3 < matrix4<T>::getLowerBound(3) || i3 > matrix4<T>::getUpperBound(3))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I3);
-	if (i4 < matrix4<T>::getLowerBound(4) || i4 > matrix4<T>::getUpperBound(4))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I4);
-	return  i1 * getDimension(1) + i2 * getDimension(2) + i3 * getDimension(3) + i4 * getDimension(4) - _dimensionSum;
 }
@@ -0,0 +1,417 @@
+#pragma once
+#include "matrixn.h"
+#include "iliffe_vector.h"
+
+template<typename T, int N, size_t Alignment>
+/// <summary>
+///   N-   ,   ,          <typeparamref name="Alignment"/> .
+/// </summary>
+/// <remarks>
+///  <see cref="cmatrix4m_aligned_layout"/>   :          ,
+///         ,     <typeparamref name="N"/> 
+///  <typeparamref name="N"/>     .
+/// </remarks>
+class cmatrixn_aligned_layout : public counted_layout
+{
+	ptrdiff_t _dimension[N];
+	ptrdiff_t _dimensionSum;
+
+public:
+	/// <summary>
+	///     <see cref="cmatrixn_aligned_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	cmatrixn_aligned_layout(const std::array<std::array<int, 2>, N>& index, T* vector);
+
+	template<typename... Index>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, Index... i) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = COLUMN_MAJOR;
+
+	/// <summary>
+	///   ,            .
+	/// </summary>
+	static const size_t alignment = Alignment;
+
+private:
+	template<size_t... K, typename... Index>
+	ptrdiff_t getOffset(std::index_sequence<K...>, Index... i) const;
+};
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_aligned_layout"/>     .
+/// </summary>
+using cmatrix2m_layout = cmatrixn_aligned_layout<T, 2, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_aligned_layout"/>     .
+/// </summary>
+using cmatrix3m_layout = cmatrixn_aligned_layout<T, 3, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_aligned_layout"/>     .
+/// </summary>
+using cmatrix5m_layout = cmatrixn_aligned_layout<T, 5, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_aligned_layout"/>     .
+/// </summary>
+using cmatrix6m_layout = cmatrixn_aligned_layout<T, 6, alignof(T)>;
+
+template<typename T, int N, size_t Alignment>
+inline cmatrixn_aligned_layout<T, N, Alignment>::cmatrixn_aligned_layout(const std::array<std::array<int, 2>, N>& index, T * vector)
+{
+	_dimension[0] = 1;
+	if constexpr (N > 1)
+		_dimension[1] = (ptrdiff_t)matrix4_storage<T>::getPitch((size_t)index[0][1] - index[0][0] + 1, Alignment);
+	for (int i = 2; i < N; i++)
+		_dimension[i] = _dimension[i - 1] * ((ptrdiff_t)index[i - 1][1] - index[i - 1][0] + 1);
+	_dimensionSum = 0;
+	for (int i = 0; i < N; i++)
+		_dimensionSum += _dimension[i] * index[i][0];
+}
+
+template<typename T, int N, size_t Alignment>
+template<typename... Index>
+inline T * cmatrixn_aligned_layout<T, N, Alignment>::address(T * vector, Index... i) const
+{
+	MATRIX4_COUNT(counter.record(ADDITION, N));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, N));
+	return vector + (getOffset(std::make_index_sequence<N>(), i...) - _dimensionSum);
+}
+
+template<typename T, int N, size_t Alignment>
+inline int cmatrixn_aligned_layout<T, N, Alignment>::getAddCount()
+{
+	return N;
+}
+
+template<typename T, int N, size_t Alignment>
+inline int cmatrixn_aligned_layout<T, N, Alignment>::getMulCount()
+{
+	return N;
+}
+
+template<typename T, int N, size_t Alignment>
+inline int cmatrixn_aligned_layout<T, N, Alignment>::getIndirectionCount()
+{
+	return 0;
+}
+
+template<typename T, int N, size_t Alignment>
+template<size_t... K, typename... Index>
+inline ptrdiff_t cmatrixn_aligned_layout<T, N, Alignment>::getOffset(std::index_sequence<K...>, Index... i) const
+{
+	return ((i * _dimension[K]) + ...);
+}
+
+template<typename T, int N>
+/// <summary>
+///   N-   ,      .
+/// </summary>
+/// <remarks>
+///  <see cref="cmatrix4_layout"/>   ;     .
+/// </remarks>
+class cmatrixn_layout : public counted_layout
+{
+	int lower[N];
+	ptrdiff_t length[N];
+
+public:
+	/// <summary>
+	///     <see cref="cmatrixn_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	cmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T* vector);
+
+	template<typename... Index>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, Index... i) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = COLUMN_MAJOR;
+
+	/// <summary>
+	///   ,            ;    .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+
+private:
+	ptrdiff_t getDimension(int dimension) const;
+
+	template<size_t... K, typename... Index>
+	ptrdiff_t getOffset(std::index_sequence<K...>, Index... i) const;
+};
+
+template<typename T, int N>
+/// <summary>
+///   N-   ,   .
+/// </summary>
+/// <remarks>
+///  <see cref="icmatrix4_layout"/>   :   <see cref="iliffe_vectorn"/>      ,      .
+/// </remarks>
+class icmatrixn_layout : public counted_layout
+{
+	iliffe_vectorn<T, N> iliffeVector;
+
+public:
+	/// <summary>
+	///     <see cref="icmatrixn_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	icmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T* vector);
+
+	template<typename... Index>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     ;     .</param>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, Index... i) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = COLUMN_MAJOR;
+
+	/// <summary>
+	///   ,            ;    .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+
+private:
+	template<size_t... K>
+	T* addressReversed(const int (&k)[N], std::index_sequence<K...>) const;
+
+	template<size_t... K>
+	static std::array<std::array<int, 2>, N> reverse(const std::array<std::array<int, 2>, N>& index, std::index_sequence<K...>);
+};
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_layout"/>  .
+/// </summary>
+using cmatrix2_layout = cmatrixn_layout<T, 2>;
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_layout"/>  .
+/// </summary>
+using cmatrix3_layout = cmatrixn_layout<T, 3>;
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_layout"/>  .
+/// </summary>
+using cmatrix5_layout = cmatrixn_layout<T, 5>;
+
+template<typename T>
+/// <summary>
+///  <see cref="cmatrixn_layout"/>  .
+/// </summary>
+using cmatrix6_layout = cmatrixn_layout<T, 6>;
+
+template<typename T>
+/// <summary>
+///  <see cref="icmatrixn_layout"/>  .
+/// </summary>
+using icmatrix2_layout = icmatrixn_layout<T, 2>;
+
+template<typename T>
+/// <summary>
+///  <see cref="icmatrixn_layout"/>  .
+/// </summary>
+using icmatrix3_layout = icmatrixn_layout<T, 3>;
+
+template<typename T>
+/// <summary>
+///  <see cref="icmatrixn_layout"/>  .
+/// </summary>
+using icmatrix5_layout = icmatrixn_layout<T, 5>;
+
+template<typename T>
+/// <summary>
+///  <see cref="icmatrixn_layout"/>  .
+/// </summary>
+using icmatrix6_layout = icmatrixn_layout<T, 6>;
+
+template<typename T, int N>
+inline cmatrixn_layout<T, N>::cmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T * vector)
+{
+	for (int i = 0; i < N; i++)
+	{
+		lower[i] = index[i][0];
+		length[i] = (ptrdiff_t)index[i][1] - index[i][0] + 1;
+	}
+}
+
+template<typename T, int N>
+template<typename... Index>
+inline T * cmatrixn_layout<T, N>::address(T * vector, Index... i) const
+{
+	MATRIX4_COUNT(counter.record(ADDITION, 2 * N - 1));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, N));
+	return vector + getOffset(std::make_index_sequence<N>(), i...);
+}
+
+template<typename T, int N>
+inline int cmatrixn_layout<T, N>::getAddCount()
+{
+	return 2 * N - 1;
+}
+
+template<typename T, int N>
+inline int cmatrixn_layout<T, N>::getMulCount()
+{
+	return N * (N + 1) / 2;
+}
+
+template<typename T, int N>
+inline int cmatrixn_layout<T, N>::getIndirectionCount()
+{
+	return 0;
+}
+
+template<typename T, int N>
+inline ptrdiff_t cmatrixn_layout<T, N>::getDimension(int dimension) const
+{
+	ptrdiff_t _dimension = 1;
+	for (int i = 0; i < dimension - 1; i++)
+	{
+		_dimension *= length[i];
+		MATRIX4_COUNT(counter.record(MULTIPLICATION, 1));
+	}
+	return _dimension;
+}
+
+template<typename T, int N>
+template<size_t... K, typename... Index>
+inline ptrdiff_t cmatrixn_layout<T, N>::getOffset(std::index_sequence<K...>, Index... i) const
+{
+	return ((((ptrdiff_t)i - lower[K]) * getDimension(K + 1)) + ...);
+}
+
+template<typename T, int N>
+inline icmatrixn_layout<T, N>::icmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T * vector) : iliffeVector(reverse(index, std::make_index_sequence<N>()), vector)
+{
+}
+
+template<typename T, int N>
+template<typename... Index>
+inline T * icmatrixn_layout<T, N>::address(T *, Index... i) const
+{
+	MATRIX4_COUNT(counter.record(INDIRECTION, N));
+	const int k[N] = { (int)i... };
+	return addressReversed(k, std::make_index_sequence<N>());
+}
+
+template<typename T, int N>
+inline int icmatrixn_layout<T, N>::getAddCount()
+{
+	return 0;
+}
+
+template<typename T, int N>
+inline int icmatrixn_layout<T, N>::getMulCount()
+{
+	return 0;
+}
+
+template<typename T, int N>
+inline int icmatrixn_layout<T, N>::getIndirectionCount()
+{
+	return N;
+}
+
+template<typename T, int N>
+template<size_t... K>
+inline T * icmatrixn_layout<T, N>::addressReversed(const int (&k)[N], std::index_sequence<K...>) const
+{
+	const int j[N] = { k[N - 1 - K]... };
+	return iliffeVector.address(j);
+}
+
+template<typename T, int N>
+template<size_t... K>
+inline std::array<std::array<int, 2>, N> icmatrixn_layout<T, N>::reverse(const std::array<std::array<int, 2>, N>& index, std::index_sequence<K...>)
+{
+	return { { index[N - 1 - K]... } };
+}
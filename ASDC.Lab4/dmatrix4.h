@@ -0,0 +1,318 @@
+#pragma once
+#include "matrix4_adapter.h"
+
+template<typename T, typename Offset>
+/// <summary>
+///      ,        .
+/// </summary>
+/// <remarks>
+///     <c>t1[i1] + t2[i2] + t3[i3] + t4[i4]</c>:        ,
+///       ,    .
+///     <typeparamref name="Offset"/>; 32-    ,
+///       <c>INT32_MAX</c>.
+/// </remarks>
+class dmatrix4_layout : public counted_layout
+{
+	Offset* tables;
+	Offset* table[4];
+
+public:
+	/// <summary>
+	///     <see cref="dmatrix4_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	/// <exception cref="std::length_error">      <typeparamref name="Offset"/>.</exception>
+	dmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	dmatrix4_layout(const dmatrix4_layout&) = delete;
+
+	dmatrix4_layout& operator=(const dmatrix4_layout&) = delete;
+
+	/// <summary>
+	///     <see cref="dmatrix4_layout"/>,      .
+	/// </summary>
+	/// <param name='other'>,      .</param>
+	dmatrix4_layout(dmatrix4_layout&& other);
+
+	/// <summary>
+	///           .
+	/// </summary>
+	/// <param name='other'>,      .</param>
+	/// <returns>   .</returns>
+	dmatrix4_layout& operator=(dmatrix4_layout&& other);
+
+	/// <summary>
+	///   ,  <see cref="dmatrix4_layout"/>.
+	/// </summary>
+	~dmatrix4_layout();
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = ROW_MAJOR;
+
+	/// <summary>
+	///   ,            ;    .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+};
+
+template<typename T>
+/// <summary>
+///  <see cref="dmatrix4_layout"/>  32- .
+/// </summary>
+using dmatrix4_layout32 = dmatrix4_layout<T, int32_t>;
+
+template<typename T>
+/// <summary>
+///  <see cref="dmatrix4_layout"/>  64- .
+/// </summary>
+using dmatrix4_layout64 = dmatrix4_layout<T, int64_t>;
+
+template<typename T>
+/// <summary>
+///      ,   ,   ,    .
+/// </summary>
+class dmatrix4 : public matrix4_adapter<T, dmatrix4_layout64>
+{
+public:
+	/// <summary>
+	///       <see cref="dmatrix4"/>    .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
+
+	/// <summary>
+	///      <see cref="dmatrix4"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
+	/// <summary>
+	///      <see cref="dmatrix4"/>    ,   ,    .
+	/// </summary>	
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='array'>,       .</param>
+	/// <param name="length">    <paramref name="array"/></param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// - -
+	///   <paramref name="array"/>  nullptr.
+	/// - -
+	///   <paramref name="length"/>  .
+	/// </exception>
+	dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
+
+	/// <summary>
+	///    <see cref="dmatrix4"/>,         .
+	/// </summary>
+	/// <remarks>    ,   <c>std::unique_ptr</c>  <c>std::vector</c>  .</remarks>
+	/// <param name='matrix'>,    .</param>
+	dmatrix4(matrix4<T, dmatrix4_layout64>&& matrix);
+
+	template<typename Source>
+	/// <summary>
+	///      <see cref="dmatrix4"/>    ,           .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
+};
+
+template<typename T, typename Offset>
+inline dmatrix4_layout<T, Offset>::dmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T *)
+{
+	size_t length[4];
+	size_t count = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		length[i] = (size_t)((ptrdiff_t)index[i][1] - index[i][0]) + 1;
+		count += length[i];
+	}
+	if (length[0] * length[1] * length[2] * length[3] - 1 > (size_t)(std::numeric_limits<Offset>::max)())
+		throw std::length_error(MESSAGE_LENGTH_ERROR_OFFSET);
+	tables = new Offset[count];
+	Offset* start = tables;
+	size_t dimension = 1;
+	for (int i = 3; i >= 0; i--)
+	{
+		for (size_t j = 0; j < length[i]; j++)
+			start[j] = (Offset)(j * dimension);
+		table[i] = start - index[i][0];
+		start += length[i];
+		dimension *= length[i];
+	}
+}
+
+template<typename T, typename Offset>
+inline dmatrix4_layout<T, Offset>::dmatrix4_layout(dmatrix4_layout && other) : counted_layout(other), tables(other.tables)
+{
+	for (int i = 0; i < 4; i++)
+		table[i] = other.table[i];
+	other.tables = nullptr;
+}
+
+template<typename T, typename Offset>
+inline dmatrix4_layout<T, Offset> & dmatrix4_layout<T, Offset>::operator=(dmatrix4_layout && other)
+{
+	if (this != &other)
+	{
+		delete[] tables;
+		counted_layout::operator=(other);
+		tables = other.tables;
+		for (int i = 0; i < 4; i++)
+			table[i] = other.table[i];
+		other.tables = nullptr;
+	}
+	return *this;
+}
+
+template<typename T, typename Offset>
+inline dmatrix4_layout<T, Offset>::~dmatrix4_layout()
+{
+	delete[] tables;
+}
+
+template<typename T, typename Offset>
+inline T * dmatrix4_layout<T, Offset>::address(T * vector, int i1, int i2, int i3, int i4) const
+{
+	MATRIX4_COUNT(counter.record(ADDITION, 3));
+	MATRIX4_COUNT(counter.record(INDIRECTION, 4));
+	return vector + (table[0][i1] + table[1][i2] + table[2][i3] + table[3][i4]);
+}
+
+template<typename T, typename Offset>
+inline int dmatrix4_layout<T, Offset>::getAddCount()
+{
+	return 3;
+}
+
+template<typename T, typename Offset>
+inline int dmatrix4_layout<T, Offset>::getMulCount()
+{
+	return 0;
+}
+
+template<typename T, typename Offset>
+inline int dmatrix4_layout<T, Offset>::getIndirectionCount()
+{
+	return 4;
+}
+
+template<typename T>
+inline dmatrix4<T>::dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4_adapter<T, dmatrix4_layout64>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+{
+}
+
+template<typename T>
+inline dmatrix4<T>::dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix4_adapter<T, dmatrix4_layout64>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
+{
+}
+
+template<typename T>
+inline dmatrix4<T>::dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4_adapter<T, dmatrix4_layout64>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+{
+}
+
+template<typename T>
+inline dmatrix4<T>::dmatrix4(matrix4<T, dmatrix4_layout64>&& matrix) : matrix4_adapter<T, dmatrix4_layout64>::matrix4_adapter(std::move(matrix))
+{
+}
+
+template<typename T>
+template<typename Source>
+inline dmatrix4<T>::dmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix4_adapter<T, dmatrix4_layout64>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
+{
+}
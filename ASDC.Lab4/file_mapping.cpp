@@ -0,0 +1,55 @@
+#include "stdafx.h"
+#include "file_mapping.h"
+
+
+file_mapping::file_mapping(const char * path) : file(INVALID_HANDLE_VALUE), mapping(nullptr), data(nullptr), size(0)
+{
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_OPEN);
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		close();
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_OPEN);
+	}
+	size = (size_t)fileSize.QuadPart;
+	if (size == 0)
+		return;
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping != nullptr)
+		data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr)
+	{
+		close();
+		throw std::runtime_error(MESSAGE_RUNTIME_ERROR_OPEN);
+	}
+}
+
+file_mapping::~file_mapping()
+{
+	close();
+}
+
+const char * file_mapping::getData() const
+{
+	return data;
+}
+
+size_t file_mapping::getSize() const
+{
+	return size;
+}
+
+void file_mapping::close()
+{
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+	data = nullptr;
+	mapping = nullptr;
+	file = INVALID_HANDLE_VALUE;
+}
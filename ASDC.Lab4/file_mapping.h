@@ -0,0 +1,46 @@
+#pragma once
+#include "resource.h"
+
+/// <summary>
+///  ,       .
+/// </summary>
+/// <remarks>
+///    : <see cref="getData"/>  nullptr,  <see cref="getSize"/>  .
+/// </remarks>
+class file_mapping
+{
+	HANDLE file;
+	HANDLE mapping;
+	const char* data;
+	size_t size;
+
+public:
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='path'>  .</param>
+	/// <exception cref="std::runtime_error">        .</exception>
+	file_mapping(const char* path);
+
+	file_mapping(const file_mapping&) = delete;
+
+	file_mapping& operator=(const file_mapping&) = delete;
+
+	/// <summary>
+	///    .
+	/// </summary>
+	~file_mapping();
+
+	/// <summary>
+	///   .
+	/// </summary>
+	const char* getData() const;
+
+	/// <summary>
+	///     .
+	/// </summary>
+	size_t getSize() const;
+
+private:
+	void close();
+};
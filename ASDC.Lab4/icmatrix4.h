@@ -1,14 +1,69 @@
 #pragma once
-#include "matrix4.h"
+#include "matrix4_adapter.h"
+#include "iliffe_vector.h"
 
 template<typename T>
 /// <summary>
-///      ,   ,   ,   .
+///      ,   .
 /// </summary>
-class icmatrix4 : public matrix4<T>
+class icmatrix4_layout : public counted_layout
 {
-	T**** iliffeVector;
+	iliffe_vector<T> iliffeVector;
+
+public:
+	/// <summary>
+	///     <see cref="icmatrix4_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	icmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = COLUMN_MAJOR;
+
+	/// <summary>
+	///   ,            ;    .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+};
 
+template<typename T>
+/// <summary>
+///      ,   ,   ,   .
+/// </summary>
+class icmatrix4 : public matrix4_adapter<T, icmatrix4_layout>
+{
 public:
 	/// <summary>
 	///       <see cref="icmatrix4"/>    .
@@ -32,6 +87,29 @@ public:
 	/// </exception>
 	icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
 
+	/// <summary>
+	///      <see cref="icmatrix4"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
 	/// <summary>
 	///      <see cref="icmatrix4"/>    ,   ,    .
 	/// </summary>	
@@ -61,96 +139,89 @@ public:
 	icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
 
 	/// <summary>
-	///       .
+	///    <see cref="icmatrix4"/>,         .
 	/// </summary>
-	/// <param name='i1'>  ,     .</param>
-	/// <param name='i2'>  ,     .</param>
-	/// <param name='i3'>  ,     .</param>
-	/// <param name='i4'>  ,     .</param>
-	/// <returns>  ,    .</returns>
-	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
-	T& at(int i1, int i2, int i3, int i4);
+	/// <remarks>    ,   <c>std::unique_ptr</c>  <c>std::vector</c>  .</remarks>
+	/// <param name='matrix'>,    .</param>
+	icmatrix4(matrix4<T, icmatrix4_layout>&& matrix);
 
+	template<typename Source>
 	/// <summary>
-	///  ,        .
+	///      <see cref="icmatrix4"/>    ,           .
 	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	int getAddCount();
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
+};
 
-	/// <summary>
-	///  ,        .
-	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	int getMulCount();
+template<typename T>
+inline icmatrix4_layout<T>::icmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T * vector) : iliffeVector({ { { index[3][0], index[3][1] }, { index[2][0], index[2][1] }, { index[1][0], index[1][1] }, { index[0][0], index[0][1] } } }, vector)
+{
+}
 
+template<typename T>
+inline T * icmatrix4_layout<T>::address(T *, int i1, int i2, int i3, int i4) const
+{
+	MATRIX4_COUNT(counter.record(INDIRECTION, 4));
+	return iliffeVector.address(i4, i3, i2, i1);
+}
 
-private:
-	//int getDimension(int index);
-};
+template<typename T>
+inline int icmatrix4_layout<T>::getAddCount()
+{
+	return 0;
+}
 
 template<typename T>
-inline icmatrix4<T>::icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+inline int icmatrix4_layout<T>::getMulCount()
 {
-	int offset = 0;
-	iliffeVector = new T***[matrix4<T>::getLength(1)] - i1l;
-	for (int i1 = i1l; i1 <= i1h; i1++)
-	{
-		iliffeVector[i1] = new T**[matrix4<T>::getLength(2)] - i2l;
-		for (int i2 = i2l; i2 <= i2h; i2++)
-		{
-			iliffeVector[i1][i2] = new T*[matrix4<T>::getLength(3)] - i3l;
-			for (int i3 = i3l; i3 <= i3h; i3++)
-			{
-				iliffeVector[i1][i2][i3] = &(matrix4<T>::_vector[offset]) - i4l;
-				offset += matrix4<T>::getLength(4);
-			}
-		}
-	}
+	return 0;
 }
 
 template<typename T>
-inline icmatrix4<T>::icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+inline int icmatrix4_layout<T>::getIndirectionCount()
 {
-	int offset = 0;
-		iliffeVector = new T***[matrix4<T>::getLength(4)] - i4l;
-	for (int i4 = i4l; i4 <= i4h; i4++)
-	{
-		iliffeVector[i4] = new T**[matrix4<T>::getLength(3)] - i3l;
-		for (int i3 = i3l; i3 <= i3h; i3++)
-		{
-			iliffeVector[i4][i3] = new T*[matrix4<T>::getLength(2)] - i2l;
-			for (int i2 = i2l; i2 <= i2h; i2++)
-			{
-				iliffeVector[i4][i3][i2] = &(matrix4<T>::_vector[offset]) - i1l;
-				offset += matrix4<T>::getLength(1);
-			}
-		}
-	}
+	return 4;
+}
 
+template<typename T>
+inline icmatrix4<T>::icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4_adapter<T, icmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+{
 }
 
 template<typename T>
-inline T & icmatrix4<T>::at(int i1, int i2, int i3, int i4)
+inline icmatrix4<T>::icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix4_adapter<T, icmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
 {
-	if (i1 < matrix4<T>::getLowerBound(1) || i1 > matrix4<T>::getUpperBound(1))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I1);
-	if (i2 < matrix4<T>::getLowerBound(2) || i2 > matrix4<T>::getUpperBound(2))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I2);
-	if (i3 < matrix4<T>::getLowerBound(3) || i3 > matrix4<T>::getUpperBound(3))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I3);
-	if (i4 < matrix4<T>::getLowerBound(4) || i4 > matrix4<T>::getUpperBound(4))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I4);
-	return iliffeVector[i4][i3][i2][i1];
 }
 
 template<typename T>
-inline int icmatrix4<T>::getAddCount()
+inline icmatrix4<T>::icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4_adapter<T, icmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
 {
-	return 0;
 }
 
 template<typename T>
-inline int icmatrix4<T>::getMulCount()
+inline icmatrix4<T>::icmatrix4(matrix4<T, icmatrix4_layout>&& matrix) : matrix4_adapter<T, icmatrix4_layout>::matrix4_adapter(std::move(matrix))
 {
-	return 0;
-}
\ No newline at end of file
+}
+
+template<typename T>
+template<typename Source>
+inline icmatrix4<T>::icmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix4_adapter<T, icmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
+{
+}
@@ -0,0 +1,265 @@
+#pragma once
+#include "matrix4_storage.h"
+
+template<typename T>
+/// <summary>
+///    ,          .
+/// </summary>
+/// <remarks>
+///        ,     ,      ,
+///   ,         .
+///  <c>j1</c>..<c>j4</c>        .
+/// </remarks>
+class iliffe_vector
+{
+	void* arena;
+	T**** iliffeVector;
+
+public:
+	/// <summary>
+	///      <see cref="iliffe_vector"/>    .
+	/// </summary>
+	/// <param name='index'>    ,    .</param>
+	/// <param name='vector'>,     ,     .</param>
+	/// <exception cref="std::bad_alloc">      .</exception>
+	iliffe_vector(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	iliffe_vector(const iliffe_vector&) = delete;
+
+	iliffe_vector& operator=(const iliffe_vector&) = delete;
+
+	/// <summary>
+	///    <see cref="iliffe_vector"/>,       .
+	/// </summary>
+	/// <param name='other'> ,       .</param>
+	iliffe_vector(iliffe_vector&& other);
+
+	/// <summary>
+	///            .
+	/// </summary>
+	/// <param name='other'> ,       .</param>
+	/// <returns>    .</returns>
+	iliffe_vector& operator=(iliffe_vector&& other);
+
+	/// <summary>
+	///   ,  <see cref="iliffe_vector"/>.
+	/// </summary>
+	~iliffe_vector();
+
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <param name='j1'>   .</param>
+	/// <param name='j2'>  .</param>
+	/// <param name='j3'>  .</param>
+	/// <param name='j4'>   .</param>
+	/// <returns>  ,    .</returns>
+	T* address(int j1, int j2, int j3, int j4) const;
+
+private:
+	static size_t align(size_t size);
+};
+
+template<typename T>
+inline iliffe_vector<T>::iliffe_vector(const std::array<std::array<int, 2>, 4>& index, T * vector)
+{
+	size_t length[4];
+	for (int i = 0; i < 4; i++)
+		length[i] = (size_t)((ptrdiff_t)index[i][1] - index[i][0]) + 1;
+	size_t size1 = align(length[0] * sizeof(T***));
+	size_t size2 = align(length[0] * length[1] * sizeof(T**));
+	size_t size3 = length[0] * length[1] * length[2] * sizeof(T*);
+	arena = _aligned_malloc(size1 + size2 + size3, CACHE_LINE_SIZE);
+	if (arena == nullptr)
+		throw std::bad_alloc();
+
+	T**** level1 = (T****)arena;
+	T*** level2 = (T***)((char*)arena + size1);
+	T** level3 = (T**)((char*)arena + size1 + size2);
+	iliffeVector = level1 - index[0][0];
+	for (size_t j1 = 0; j1 < length[0]; j1++)
+	{
+		level1[j1] = level2 + j1 * length[1] - index[1][0];
+		for (size_t j2 = 0; j2 < length[1]; j2++)
+		{
+			size_t row = j1 * length[1] + j2;
+			level2[row] = level3 + row * length[2] - index[2][0];
+			for (size_t j3 = 0; j3 < length[2]; j3++)
+				level3[row * length[2] + j3] = vector + (row * length[2] + j3) * length[3] - index[3][0];
+		}
+	}
+}
+
+template<typename T>
+inline iliffe_vector<T>::iliffe_vector(iliffe_vector && other) : arena(other.arena), iliffeVector(other.iliffeVector)
+{
+	other.arena = nullptr;
+	other.iliffeVector = nullptr;
+}
+
+template<typename T>
+inline iliffe_vector<T> & iliffe_vector<T>::operator=(iliffe_vector && other)
+{
+	if (this != &other)
+	{
+		_aligned_free(arena);
+		arena = other.arena;
+		iliffeVector = other.iliffeVector;
+		other.arena = nullptr;
+		other.iliffeVector = nullptr;
+	}
+	return *this;
+}
+
+template<typename T>
+inline iliffe_vector<T>::~iliffe_vector()
+{
+	_aligned_free(arena);
+}
+
+template<typename T>
+inline T * iliffe_vector<T>::address(int j1, int j2, int j3, int j4) const
+{
+	return &iliffeVector[j1][j2][j3][j4];
+}
+
+template<typename T>
+inline size_t iliffe_vector<T>::align(size_t size)
+{
+	return (size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+
+template<typename T, int N>
+/// <summary>
+///    N-   <c>N - 1</c>  , ,   <see cref="iliffe_vector"/>,      .
+/// </summary>
+/// <remarks>
+///       ,    <c>void*</c>,          .
+///               .
+/// </remarks>
+class iliffe_vectorn
+{
+	void* arena;
+	const void* iliffeVector;
+
+public:
+	/// <summary>
+	///      <see cref="iliffe_vectorn"/>    .
+	/// </summary>
+	/// <param name='index'>    ,    .</param>
+	/// <param name='vector'>,     ,     .</param>
+	/// <exception cref="std::bad_alloc">      .</exception>
+	iliffe_vectorn(const std::array<std::array<int, 2>, N>& index, T* vector);
+
+	iliffe_vectorn(const iliffe_vectorn&) = delete;
+
+	iliffe_vectorn& operator=(const iliffe_vectorn&) = delete;
+
+	/// <summary>
+	///    <see cref="iliffe_vectorn"/>,       .
+	/// </summary>
+	/// <param name='other'> ,       .</param>
+	iliffe_vectorn(iliffe_vectorn&& other);
+
+	/// <summary>
+	///            .
+	/// </summary>
+	/// <param name='other'> ,       .</param>
+	/// <returns>    .</returns>
+	iliffe_vectorn& operator=(iliffe_vectorn&& other);
+
+	/// <summary>
+	///   ,  <see cref="iliffe_vectorn"/>.
+	/// </summary>
+	~iliffe_vectorn();
+
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <param name='j'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T* address(const int (&j)[N]) const;
+
+private:
+	template<size_t... K>
+	T* address(const int (&j)[N], std::index_sequence<K...>) const;
+
+	static size_t align(size_t size);
+};
+
+template<typename T, int N>
+inline iliffe_vectorn<T, N>::iliffe_vectorn(const std::array<std::array<int, 2>, N>& index, T * vector)
+{
+	static_assert(N >= 2, "        .");
+	//  d         d + 1 
+	size_t count[N - 1], offset[N - 1], size = 0;
+	for (int d = 0; d < N - 1; d++)
+	{
+		count[d] = (d == 0 ? 1 : count[d - 1]) * ((size_t)((ptrdiff_t)index[d][1] - index[d][0]) + 1);
+		offset[d] = size;
+		size += align(count[d] * sizeof(void*));
+	}
+	arena = _aligned_malloc(size, CACHE_LINE_SIZE);
+	if (arena == nullptr)
+		throw std::bad_alloc();
+
+	for (int d = 0; d < N - 1; d++)
+	{
+		void** level = (void**)((char*)arena + offset[d]);
+		size_t length = (size_t)((ptrdiff_t)index[d + 1][1] - index[d + 1][0]) + 1;
+		for (size_t k = 0; k < count[d]; k++)
+			if (d + 1 < N - 1)
+				level[k] = (void**)((char*)arena + offset[d + 1]) + k * length - index[d + 1][0];
+			else
+				level[k] = vector + k * length - index[d + 1][0];
+	}
+	iliffeVector = (void**)arena - index[0][0];
+}
+
+template<typename T, int N>
+inline iliffe_vectorn<T, N>::iliffe_vectorn(iliffe_vectorn && other) : arena(other.arena), iliffeVector(other.iliffeVector)
+{
+	other.arena = nullptr;
+	other.iliffeVector = nullptr;
+}
+
+template<typename T, int N>
+inline iliffe_vectorn<T, N> & iliffe_vectorn<T, N>::operator=(iliffe_vectorn && other)
+{
+	if (this != &other)
+	{
+		_aligned_free(arena);
+		arena = other.arena;
+		iliffeVector = other.iliffeVector;
+		other.arena = nullptr;
+		other.iliffeVector = nullptr;
+	}
+	return *this;
+}
+
+template<typename T, int N>
+inline iliffe_vectorn<T, N>::~iliffe_vectorn()
+{
+	_aligned_free(arena);
+}
+
+template<typename T, int N>
+inline T * iliffe_vectorn<T, N>::address(const int (&j)[N]) const
+{
+	return address(j, std::make_index_sequence<N - 1>());
+}
+
+template<typename T, int N>
+template<size_t... K>
+inline T * iliffe_vectorn<T, N>::address(const int (&j)[N], std::index_sequence<K...>) const
+{
+	const void* level = iliffeVector;
+	((level = ((void* const*)level)[j[K]]), ...);
+	return (T*)level + j[N - 1];
+}
+
+template<typename T, int N>
+inline size_t iliffe_vectorn<T, N>::align(size_t size)
+{
+	return (size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
@@ -1,16 +1,86 @@
 #pragma once
-#include "matrix4.h"
-#include "resource.h"
+#include "matrix4_adapter.h"
+
+template<typename T, size_t Alignment>
+/// <summary>
+///      ,   ,           <typeparamref name="Alignment"/> .
+/// </summary>
+/// <remarks>
+///        ,  <typeparamref name="Alignment"/> ,   
+///           ;       .
+///  <c>Alignment</c>,  <c>alignof(T)</c>,    .
+/// </remarks>
+class lmatrix4m_aligned_layout : public counted_layout
+{
+	ptrdiff_t _dimension[4];
+	ptrdiff_t _dimensionSum;
+
+public:
+	/// <summary>
+	///     <see cref="lmatrix4m_aligned_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	lmatrix4m_aligned_layout(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = ROW_MAJOR;
+
+	/// <summary>
+	///   ,            .
+	/// </summary>
+	static const size_t alignment = Alignment;
+};
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrix4m_aligned_layout"/>   .
+/// </summary>
+using lmatrix4m_layout = lmatrix4m_aligned_layout<T, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrix4m_aligned_layout"/>  ,      (64 ).
+/// </summary>
+using lmatrix4m_layout64 = lmatrix4m_aligned_layout<T, CACHE_LINE_SIZE>;
 
 template<typename T>
 /// <summary>
 ///      ,   ,   ,   .
 /// </summary>
-class lmatrix4m : public matrix4<T>
+class lmatrix4m : public matrix4_adapter<T, lmatrix4m_layout>
 {
-	int* _dimension;
-	int _dimensionSum;
-
 public:
 	/// <summary>
 	///       <see cref="lmatrix4m"/>    .
@@ -34,6 +104,29 @@ public:
 	/// </exception>
 	lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
 
+	/// <summary>
+	///      <see cref="lmatrix4m"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
 	/// <summary>
 	///      <see cref="lmatrix4m"/>    ,   ,    .
 	/// </summary>	
@@ -63,91 +156,95 @@ public:
 	lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
 
 	/// <summary>
-	///   ,  <see cref="lmatrix4m"/>.
+	///    <see cref="lmatrix4m"/>,         .
 	/// </summary>
-	~lmatrix4m();
+	/// <remarks>    ,   <c>std::unique_ptr</c>  <c>std::vector</c>  .</remarks>
+	/// <param name='matrix'>,    .</param>
+	lmatrix4m(matrix4<T, lmatrix4m_layout>&& matrix);
 
+	template<typename Source>
 	/// <summary>
-	///       .
+	///      <see cref="lmatrix4m"/>    ,           .
 	/// </summary>
-	/// <param name='i1'>  ,     .</param>
-	/// <param name='i2'>  ,     .</param>
-	/// <param name='i3'>  ,     .</param>
-	/// <param name='i4'>  ,     .</param>
-	/// <returns>  ,    .</returns>
-	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
-	T& at(int i1, int i2, int i3, int i4);
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
+};
 
-	/// <summary>
-	///  ,        .
-	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	int getAddCount();
+template<typename T, size_t Alignment>
+inline lmatrix4m_aligned_layout<T, Alignment>::lmatrix4m_aligned_layout(const std::array<std::array<int, 2>, 4>& index, T *)
+{
+	_dimension[3] = 1;
+	_dimension[2] = (ptrdiff_t)matrix4_storage<T>::getPitch((size_t)index[3][1] - index[3][0] + 1, Alignment);
+	for (int i = 1; i >= 0; i--)
+		_dimension[i] = _dimension[i + 1] * ((ptrdiff_t)index[i + 1][1] - index[i + 1][0] + 1);
+	_dimensionSum = _dimension[0] * index[0][0] + _dimension[1] * index[1][0] + _dimension[2] * index[2][0] + _dimension[3] * index[3][0];
+}
 
-	/// <summary>
-	///  ,        .
-	/// </summary>
-	/// <returns>32-    ,        .</returns>
-	int getMulCount();
+template<typename T, size_t Alignment>
+inline T * lmatrix4m_aligned_layout<T, Alignment>::address(T * vector, int i1, int i2, int i3, int i4) const
+{
+	MATRIX4_COUNT(counter.record(ADDITION, 4));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, 4));
+	return vector + (i1 * _dimension[0] + i2 * _dimension[1] + i3 * _dimension[2] + i4 * _dimension[3] - _dimensionSum);
+}
 
-private:
-	int getDimension(int dimension);
-};
+template<typename T, size_t Alignment>
+inline int lmatrix4m_aligned_layout<T, Alignment>::getAddCount()
+{
+	return 4;
+}
 
-template<typename T>
-inline lmatrix4m<T>::lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+template<typename T, size_t Alignment>
+inline int lmatrix4m_aligned_layout<T, Alignment>::getMulCount()
 {
-	_dimension = new int[4];
-	_dimension[3] = 1;
-	for (int i = 2; i >= 0; i--)
-		_dimension[i] = _dimension[i + 1] * matrix4<T>::getLength(i + 2);
-	_dimensionSum = _dimension[0] * this->getLowerBound(1) + _dimension[1] * this->getLowerBound(2) + _dimension[2] * this->getLowerBound(3) + _dimension[3] * this->getLowerBound(4);
+	return 4;
 }
 
-template<typename T>
-inline lmatrix4m<T>::lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4<T>::matrix4(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+template<typename T, size_t Alignment>
+inline int lmatrix4m_aligned_layout<T, Alignment>::getIndirectionCount()
 {
-	_dimension = new int[4];
-	_dimension[3] = 1;
-	for (int i = 2; i >= 0; i--)
-		_dimension[i] = _dimension[i + 1] * matrix4<T>::getLength(i + 2);
-	_dimensionSum = _dimension[0] * this->getLowerBound(1) + _dimension[1] * this->getLowerBound(2) + _dimension[2] * this->getLowerBound(3) + _dimension[3] * this->getLowerBound(4);
+	return 0;
 }
 
 template<typename T>
-inline lmatrix4m<T>::~lmatrix4m()
+inline lmatrix4m<T>::lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4_adapter<T, lmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
 {
-	delete[] _dimension;
 }
 
 template<typename T>
-inline T & lmatrix4m<T>::at(int i1, int i2, int i3, int i4)
+inline lmatrix4m<T>::lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix4_adapter<T, lmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
 {
-	if (i1 < matrix4<T>::getLowerBound(1) || i1 > matrix4<T>::getUpperBound(1))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I1);
-	if (i2 < matrix4<T>::getLowerBound(2) || i2 > matrix4<T>::getUpperBound(2))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I2);
-	if (i3 < matrix4<T>::getLowerBound(3) || i3 > matrix4<T>::getUpperBound(3))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I3);
-	if (i4 < matrix4<T>::getLowerBound(4) || i4 > matrix4<T>::getUpperBound(4))
-		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I4);
-	return  matrix4<T>::_vector[i1 * getDimension(1) + i2 * getDimension(2) + i3 * getDimension(3) + i4 * getDimension(4) - _dimensionSum];
 }
 
 template<typename T>
-inline int lmatrix4m<T>::getAddCount()
+inline lmatrix4m<T>::lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4_adapter<T, lmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
 {
-	return 4;
 }
 
 template<typename T>
-inline int lmatrix4m<T>::getDimension(int dimension)
+inline lmatrix4m<T>::lmatrix4m(matrix4<T, lmatrix4m_layout>&& matrix) : matrix4_adapter<T, lmatrix4m_layout>::matrix4_adapter(std::move(matrix))
 {
-	return _dimension[dimension - 1];
 }
 
 template<typename T>
-inline int lmatrix4m<T>::getMulCount()
+template<typename Source>
+inline lmatrix4m<T>::lmatrix4m(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix4_adapter<T, lmatrix4m_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
 {
-	return 4;
 }
@@ -0,0 +1,395 @@
+#pragma once
+#include "matrixn.h"
+#include "iliffe_vector.h"
+
+template<typename T, int N, size_t Alignment>
+/// <summary>
+///   N-   ,   ,          <typeparamref name="Alignment"/> .
+/// </summary>
+/// <remarks>
+///  <see cref="lmatrix4m_aligned_layout"/>   :          ,
+///         ,     <typeparamref name="N"/> 
+///  <typeparamref name="N"/>     .
+/// </remarks>
+class lmatrixn_aligned_layout : public counted_layout
+{
+	ptrdiff_t _dimension[N];
+	ptrdiff_t _dimensionSum;
+
+public:
+	/// <summary>
+	///     <see cref="lmatrixn_aligned_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	lmatrixn_aligned_layout(const std::array<std::array<int, 2>, N>& index, T* vector);
+
+	template<typename... Index>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, Index... i) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = ROW_MAJOR;
+
+	/// <summary>
+	///   ,            .
+	/// </summary>
+	static const size_t alignment = Alignment;
+
+private:
+	template<size_t... K, typename... Index>
+	ptrdiff_t getOffset(std::index_sequence<K...>, Index... i) const;
+};
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_aligned_layout"/>     .
+/// </summary>
+using lmatrix2m_layout = lmatrixn_aligned_layout<T, 2, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_aligned_layout"/>     .
+/// </summary>
+using lmatrix3m_layout = lmatrixn_aligned_layout<T, 3, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_aligned_layout"/>     .
+/// </summary>
+using lmatrix5m_layout = lmatrixn_aligned_layout<T, 5, alignof(T)>;
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_aligned_layout"/>     .
+/// </summary>
+using lmatrix6m_layout = lmatrixn_aligned_layout<T, 6, alignof(T)>;
+
+template<typename T, int N, size_t Alignment>
+inline lmatrixn_aligned_layout<T, N, Alignment>::lmatrixn_aligned_layout(const std::array<std::array<int, 2>, N>& index, T * vector)
+{
+	_dimension[N - 1] = 1;
+	if constexpr (N > 1)
+		_dimension[N - 2] = (ptrdiff_t)matrix4_storage<T>::getPitch((size_t)index[N - 1][1] - index[N - 1][0] + 1, Alignment);
+	for (int i = N - 3; i >= 0; i--)
+		_dimension[i] = _dimension[i + 1] * ((ptrdiff_t)index[i + 1][1] - index[i + 1][0] + 1);
+	_dimensionSum = 0;
+	for (int i = 0; i < N; i++)
+		_dimensionSum += _dimension[i] * index[i][0];
+}
+
+template<typename T, int N, size_t Alignment>
+template<typename... Index>
+inline T * lmatrixn_aligned_layout<T, N, Alignment>::address(T * vector, Index... i) const
+{
+	MATRIX4_COUNT(counter.record(ADDITION, N));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, N));
+	return vector + (getOffset(std::make_index_sequence<N>(), i...) - _dimensionSum);
+}
+
+template<typename T, int N, size_t Alignment>
+inline int lmatrixn_aligned_layout<T, N, Alignment>::getAddCount()
+{
+	return N;
+}
+
+template<typename T, int N, size_t Alignment>
+inline int lmatrixn_aligned_layout<T, N, Alignment>::getMulCount()
+{
+	return N;
+}
+
+template<typename T, int N, size_t Alignment>
+inline int lmatrixn_aligned_layout<T, N, Alignment>::getIndirectionCount()
+{
+	return 0;
+}
+
+template<typename T, int N, size_t Alignment>
+template<size_t... K, typename... Index>
+inline ptrdiff_t lmatrixn_aligned_layout<T, N, Alignment>::getOffset(std::index_sequence<K...>, Index... i) const
+{
+	return ((i * _dimension[K]) + ...);
+}
+
+template<typename T, int N>
+/// <summary>
+///   N-   ,      .
+/// </summary>
+/// <remarks>
+///  <see cref="lmatrix4_layout"/>   ;     .
+/// </remarks>
+class lmatrixn_layout : public counted_layout
+{
+	int lower[N];
+	ptrdiff_t length[N];
+
+public:
+	/// <summary>
+	///     <see cref="lmatrixn_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	lmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T* vector);
+
+	template<typename... Index>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, Index... i) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = ROW_MAJOR;
+
+	/// <summary>
+	///   ,            ;    .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+
+private:
+	ptrdiff_t getDimension(int dimension) const;
+
+	template<size_t... K, typename... Index>
+	ptrdiff_t getOffset(std::index_sequence<K...>, Index... i) const;
+};
+
+template<typename T, int N>
+/// <summary>
+///   N-   ,   .
+/// </summary>
+/// <remarks>
+///  <see cref="ilmatrix4_layout"/>   :     <see cref="iliffe_vectorn"/>    .
+/// </remarks>
+class ilmatrixn_layout : public counted_layout
+{
+	iliffe_vectorn<T, N> iliffeVector;
+
+public:
+	/// <summary>
+	///     <see cref="ilmatrixn_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	ilmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T* vector);
+
+	template<typename... Index>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     ;     .</param>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, Index... i) const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static int getIndirectionCount();
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = ROW_MAJOR;
+
+	/// <summary>
+	///   ,            ;    .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+};
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_layout"/>  .
+/// </summary>
+using lmatrix2_layout = lmatrixn_layout<T, 2>;
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_layout"/>  .
+/// </summary>
+using lmatrix3_layout = lmatrixn_layout<T, 3>;
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_layout"/>  .
+/// </summary>
+using lmatrix5_layout = lmatrixn_layout<T, 5>;
+
+template<typename T>
+/// <summary>
+///  <see cref="lmatrixn_layout"/>  .
+/// </summary>
+using lmatrix6_layout = lmatrixn_layout<T, 6>;
+
+template<typename T>
+/// <summary>
+///  <see cref="ilmatrixn_layout"/>  .
+/// </summary>
+using ilmatrix2_layout = ilmatrixn_layout<T, 2>;
+
+template<typename T>
+/// <summary>
+///  <see cref="ilmatrixn_layout"/>  .
+/// </summary>
+using ilmatrix3_layout = ilmatrixn_layout<T, 3>;
+
+template<typename T>
+/// <summary>
+///  <see cref="ilmatrixn_layout"/>  .
+/// </summary>
+using ilmatrix5_layout = ilmatrixn_layout<T, 5>;
+
+template<typename T>
+/// <summary>
+///  <see cref="ilmatrixn_layout"/>  .
+/// </summary>
+using ilmatrix6_layout = ilmatrixn_layout<T, 6>;
+
+template<typename T, int N>
+inline lmatrixn_layout<T, N>::lmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T * vector)
+{
+	for (int i = 0; i < N; i++)
+	{
+		lower[i] = index[i][0];
+		length[i] = (ptrdiff_t)index[i][1] - index[i][0] + 1;
+	}
+}
+
+template<typename T, int N>
+template<typename... Index>
+inline T * lmatrixn_layout<T, N>::address(T * vector, Index... i) const
+{
+	MATRIX4_COUNT(counter.record(ADDITION, 2 * N - 1));
+	MATRIX4_COUNT(counter.record(MULTIPLICATION, N));
+	return vector + getOffset(std::make_index_sequence<N>(), i...);
+}
+
+template<typename T, int N>
+inline int lmatrixn_layout<T, N>::getAddCount()
+{
+	return 2 * N - 1;
+}
+
+template<typename T, int N>
+inline int lmatrixn_layout<T, N>::getMulCount()
+{
+	return N * (N + 1) / 2;
+}
+
+template<typename T, int N>
+inline int lmatrixn_layout<T, N>::getIndirectionCount()
+{
+	return 0;
+}
+
+template<typename T, int N>
+inline ptrdiff_t lmatrixn_layout<T, N>::getDimension(int dimension) const
+{
+	ptrdiff_t _dimension = 1;
+	for (int i = N - 1; i >= dimension; i--)
+	{
+		_dimension *= length[i];
+		MATRIX4_COUNT(counter.record(MULTIPLICATION, 1));
+	}
+	return _dimension;
+}
+
+template<typename T, int N>
+template<size_t... K, typename... Index>
+inline ptrdiff_t lmatrixn_layout<T, N>::getOffset(std::index_sequence<K...>, Index... i) const
+{
+	return ((((ptrdiff_t)i - lower[K]) * getDimension(K + 1)) + ...);
+}
+
+template<typename T, int N>
+inline ilmatrixn_layout<T, N>::ilmatrixn_layout(const std::array<std::array<int, 2>, N>& index, T * vector) : iliffeVector(index, vector)
+{
+}
+
+template<typename T, int N>
+template<typename... Index>
+inline T * ilmatrixn_layout<T, N>::address(T *, Index... i) const
+{
+	MATRIX4_COUNT(counter.record(INDIRECTION, N));
+	const int j[N] = { (int)i... };
+	return iliffeVector.address(j);
+}
+
+template<typename T, int N>
+inline int ilmatrixn_layout<T, N>::getAddCount()
+{
+	return 0;
+}
+
+template<typename T, int N>
+inline int ilmatrixn_layout<T, N>::getMulCount()
+{
+	return 0;
+}
+
+template<typename T, int N>
+inline int ilmatrixn_layout<T, N>::getIndirectionCount()
+{
+	return N;
+}
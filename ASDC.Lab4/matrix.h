@@ -2,9 +2,21 @@
 
 #include "_matrix4.h"
 #include "matrix4.h"
+#include "lmatrixn.h"
+#include "cmatrixn.h"
+#include "matrix4_adapter.h"
 #include "cmatrix4.h"
 #include "cmatrix4m.h"
 #include "lmatrix4.h"
 #include "lmatrix4m.h"
 #include "icmatrix4.h"
-#include "ilmatrix4.h"
\ No newline at end of file
+#include "ilmatrix4.h"
+#include "dmatrix4.h"
+#include "zmatrix4.h"
+#include "bmatrix4.h"
+#include "smatrix4.h"
+#include "static_matrix4.h"
+#include "simd_kernels.h"
+#include "matrix4_kernels.h"
+#include "matrix4_parallel.h"
+#include "matrix4_stencil.h"
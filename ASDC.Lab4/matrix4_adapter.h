@@ -0,0 +1,278 @@
+#pragma once
+#include "matrix4.h"
+
+template<typename T, template<typename> class Layout>
+/// <summary>
+///    <see cref="matrix4"/>  ,      .
+/// </summary>
+/// <remarks>
+///  -   <see cref="getMatrix"/>,  ,    ,       .
+/// </remarks>
+class matrix4_adapter : public matrix4<T>
+{
+	matrix4<T, Layout> matrix;
+
+public:
+	/// <summary>
+	///       <see cref="matrix4_adapter"/>    .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
+
+	/// <summary>
+	///      <see cref="matrix4_adapter"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
+	/// <summary>
+	///      <see cref="matrix4_adapter"/>    ,   ,    .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='array'>,       .</param>
+	/// <param name="length">    <paramref name="array"/></param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// - -
+	///   <paramref name="array"/>  nullptr.
+	/// - -
+	///   <paramref name="length"/>  .
+	/// </exception>
+	matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
+
+	/// <summary>
+	///    <see cref="matrix4_adapter"/>,     <typeparamref name="Layout"/>   .
+	/// </summary>
+	/// <param name='matrix'>,    .</param>
+	matrix4_adapter(matrix4<T, Layout>&& matrix);
+
+	matrix4_adapter(matrix4_adapter&&) = default;
+
+	matrix4_adapter& operator=(matrix4_adapter&&) = default;
+
+	template<typename Source>
+	/// <summary>
+	///      <see cref="matrix4_adapter"/>    ,           .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='i1'>  ,     .</param>
+	/// <param name='i2'>  ,     .</param>
+	/// <param name='i3'>  ,     .</param>
+	/// <param name='i4'>  ,     .</param>
+	/// <returns>  ,    .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	T& at(int i1, int i2, int i3, int i4);
+
+	/// <summary>
+	///         <see cref="matrix4_adapter"/>.
+	/// </summary>
+	size_t getLength();
+
+	/// <summary>
+	///  ,        <see cref="matrix4_adapter"/>.
+	/// </summary>
+	/// <param name='dimension'>  <see cref="matrix4_adapter"/>,     ,     .</param>
+	/// <returns>32-    ,      .</returns>
+	/// <exception cref="std::out_of_range">
+	///   <paramref name="dimension"/>  .
+	/// -  -
+	///   <paramref name="dimension"/>  .
+	/// </exception>
+	int getLength(int dimension);
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	int getIndirectionCount();
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">
+	///   <paramref name="dimension"/>  .
+	/// -  -
+	///   <paramref name="dimension"/>  .
+	/// </exception>
+	int getLowerBound(int dimension);
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">
+	///   <paramref name="dimension"/>  .
+	/// -  -
+	///   <paramref name="dimension"/>  .
+	/// </exception>
+	int getUpperBound(int dimension);
+
+	/// <summary>
+	///     <typeparamref name="Layout"/>,        .
+	/// </summary>
+	/// <returns>  ,    -.</returns>
+	matrix4<T, Layout>& getMatrix();
+};
+
+template<typename T, template<typename> class Layout>
+inline matrix4_adapter<T, Layout>::matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+{
+}
+
+template<typename T, template<typename> class Layout>
+inline matrix4_adapter<T, Layout>::matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
+{
+}
+
+template<typename T, template<typename> class Layout>
+inline matrix4_adapter<T, Layout>::matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+{
+}
+
+template<typename T, template<typename> class Layout>
+inline matrix4_adapter<T, Layout>::matrix4_adapter(matrix4<T, Layout>&& matrix) : matrix(std::move(matrix))
+{
+}
+
+template<typename T, template<typename> class Layout>
+template<typename Source>
+inline matrix4_adapter<T, Layout>::matrix4_adapter(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
+{
+}
+
+template<typename T, template<typename> class Layout>
+inline T & matrix4_adapter<T, Layout>::at(int i1, int i2, int i3, int i4)
+{
+	return matrix.at(i1, i2, i3, i4);
+}
+
+template<typename T, template<typename> class Layout>
+inline size_t matrix4_adapter<T, Layout>::getLength()
+{
+	return matrix.getLength();
+}
+
+template<typename T, template<typename> class Layout>
+inline int matrix4_adapter<T, Layout>::getLength(int dimension)
+{
+	return matrix.getLength(dimension);
+}
+
+template<typename T, template<typename> class Layout>
+inline int matrix4_adapter<T, Layout>::getAddCount()
+{
+	return matrix.getAddCount();
+}
+
+template<typename T, template<typename> class Layout>
+inline int matrix4_adapter<T, Layout>::getMulCount()
+{
+	return matrix.getMulCount();
+}
+
+template<typename T, template<typename> class Layout>
+inline int matrix4_adapter<T, Layout>::getIndirectionCount()
+{
+	return matrix.getIndirectionCount();
+}
+
+template<typename T, template<typename> class Layout>
+inline int matrix4_adapter<T, Layout>::getLowerBound(int dimension)
+{
+	return matrix.getLowerBound(dimension);
+}
+
+template<typename T, template<typename> class Layout>
+inline int matrix4_adapter<T, Layout>::getUpperBound(int dimension)
+{
+	return matrix.getUpperBound(dimension);
+}
+
+template<typename T, template<typename> class Layout>
+inline matrix4<T, Layout>& matrix4_adapter<T, Layout>::getMatrix()
+{
+	return matrix;
+}
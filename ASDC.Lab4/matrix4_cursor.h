@@ -0,0 +1,333 @@
+#pragma once
+#include "storage_order.h"
+#include "morton_code.h"
+
+template<typename T, STORAGE_ORDER Order>
+/// <summary>
+///           .
+/// </summary>
+/// <remarks>
+///         ,        ,
+///          .
+///      ,         .
+///    <see cref="moveNext"/>     .
+/// </remarks>
+class matrix4_cursor
+{
+	T* vector;
+	ptrdiff_t offset;
+	ptrdiff_t padding;
+	int index[4];
+	int lower[4];
+	int upper[4];
+
+public:
+	/// <summary>
+	///     <see cref="matrix4_cursor"/>      .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='index'>     .</param>
+	/// <param name='pitch'>  ,        .</param>
+	matrix4_cursor(T* vector, const std::array<std::array<int, 2>, 4>& index, size_t pitch);
+
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <returns>true,      ; false,    .</returns>
+	bool moveNext();
+
+	/// <summary>
+	///  ,    .
+	/// </summary>
+	/// <returns>   .</returns>
+	T& getCurrent();
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='dimension'> ,     .</param>
+	/// <returns>     .</returns>
+	int getIndex(int dimension);
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <returns>     .</returns>
+	ptrdiff_t getOffset();
+
+private:
+	static int getDimension(int step);
+};
+
+template<typename T>
+/// <summary>
+///     ,    ,      .
+/// </summary>
+/// <remarks>
+///          (<see cref="morton_code::moveNext"/>),       .
+///    <see cref="moveNext"/>     ,       .
+/// </remarks>
+class matrix4_cursor<T, Z_ORDER>
+{
+	T* vector;
+	ptrdiff_t offset;
+	morton_code code;
+	size_t shift[4];
+	int lower[4];
+
+public:
+	/// <summary>
+	///     <see cref="matrix4_cursor"/>      .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='index'>     .</param>
+	/// <param name='pitch'> ;       .</param>
+	matrix4_cursor(T* vector, const std::array<std::array<int, 2>, 4>& index, size_t pitch);
+
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <returns>true,      ; false,    .</returns>
+	bool moveNext();
+
+	/// <summary>
+	///  ,    .
+	/// </summary>
+	/// <returns>   .</returns>
+	T& getCurrent();
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='dimension'> ,     .</param>
+	/// <returns>     .</returns>
+	int getIndex(int dimension);
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <returns>     .</returns>
+	ptrdiff_t getOffset();
+};
+
+template<typename T>
+/// <summary>
+///     ,    (<c>TILED</c>),      .
+/// </summary>
+/// <remarks>
+///      ,     ,       ,   
+///     ;           ,     .
+///    <see cref="moveNext"/>     ,       .
+/// </remarks>
+class matrix4_cursor<T, TILED>
+{
+	T* vector;
+	ptrdiff_t offset;
+	ptrdiff_t first;
+	ptrdiff_t step[4];
+	int index[4];
+	int base[4];
+	int lower[4];
+	int upper[4];
+	int tile[4];
+
+public:
+	/// <summary>
+	///     <see cref="matrix4_cursor"/>         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='index'>     .</param>
+	/// <param name='tile'>   .</param>
+	matrix4_cursor(T* vector, const std::array<std::array<int, 2>, 4>& index, const int (&tile)[4]);
+
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <returns>true,      ; false,    .</returns>
+	bool moveNext();
+
+	/// <summary>
+	///  ,    .
+	/// </summary>
+	/// <returns>   .</returns>
+	T& getCurrent();
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='dimension'> ,     .</param>
+	/// <returns>     .</returns>
+	int getIndex(int dimension);
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <returns>     .</returns>
+	ptrdiff_t getOffset();
+};
+
+template<typename T, STORAGE_ORDER Order>
+inline matrix4_cursor<T, Order>::matrix4_cursor(T * vector, const std::array<std::array<int, 2>, 4>& index, size_t pitch) : vector(vector), offset(-1)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		this->index[i] = index[i][0];
+		lower[i] = index[i][0];
+		upper[i] = index[i][1];
+	}
+	this->index[getDimension(0)]--;
+	padding = (ptrdiff_t)pitch - (upper[getDimension(0)] - lower[getDimension(0)] + 1);
+}
+
+template<typename T, STORAGE_ORDER Order>
+inline bool matrix4_cursor<T, Order>::moveNext()
+{
+	offset++;
+	for (int step = 0; step < 4; step++)
+	{
+		int dimension = getDimension(step);
+		if (++index[dimension] <= upper[dimension])
+			return true;
+		index[dimension] = lower[dimension];
+		if (step == 0)
+			offset += padding;
+	}
+	for (int i = 0; i < 4; i++)
+		index[i] = upper[i];
+	offset -= padding + 1;
+	return false;
+}
+
+template<typename T, STORAGE_ORDER Order>
+inline T & matrix4_cursor<T, Order>::getCurrent()
+{
+	return vector[offset];
+}
+
+template<typename T, STORAGE_ORDER Order>
+inline int matrix4_cursor<T, Order>::getIndex(int dimension)
+{
+	return index[dimension - 1];
+}
+
+template<typename T, STORAGE_ORDER Order>
+inline ptrdiff_t matrix4_cursor<T, Order>::getOffset()
+{
+	return offset;
+}
+
+template<typename T, STORAGE_ORDER Order>
+inline int matrix4_cursor<T, Order>::getDimension(int step)
+{
+	return Order == ROW_MAJOR ? 3 - step : step;
+}
+
+template<typename T>
+inline matrix4_cursor<T, Z_ORDER>::matrix4_cursor(T * vector, const std::array<std::array<int, 2>, 4>& index, size_t) : vector(vector), offset(-1), code(index), shift{ 0, 0, 0, 0 }
+{
+	for (int i = 0; i < 4; i++)
+		lower[i] = index[i][0];
+}
+
+template<typename T>
+inline bool matrix4_cursor<T, Z_ORDER>::moveNext()
+{
+	if (offset < 0)
+	{
+		offset = 0;
+		return true;
+	}
+	size_t cell = (size_t)offset;
+	if (!code.moveNext(cell, shift))
+		return false;
+	offset = (ptrdiff_t)cell;
+	return true;
+}
+
+template<typename T>
+inline T & matrix4_cursor<T, Z_ORDER>::getCurrent()
+{
+	return vector[offset];
+}
+
+template<typename T>
+inline int matrix4_cursor<T, Z_ORDER>::getIndex(int dimension)
+{
+	return lower[dimension - 1] + (int)shift[dimension - 1];
+}
+
+template<typename T>
+inline ptrdiff_t matrix4_cursor<T, Z_ORDER>::getOffset()
+{
+	return offset;
+}
+
+template<typename T>
+inline matrix4_cursor<T, TILED>::matrix4_cursor(T * vector, const std::array<std::array<int, 2>, 4>& index, const int (&tile)[4]) : vector(vector), offset(-1), first(0)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		this->index[i] = index[i][0];
+		base[i] = index[i][0];
+		lower[i] = index[i][0];
+		upper[i] = index[i][1];
+		this->tile[i] = tile[i];
+	}
+	step[3] = 1;
+	for (int i = 2; i >= 0; i--)
+		step[i] = step[i + 1] * tile[i + 1];
+}
+
+template<typename T>
+inline bool matrix4_cursor<T, TILED>::moveNext()
+{
+	if (offset < 0)
+	{
+		offset = 0;
+		return true;
+	}
+	for (int i = 3; i >= 0; i--)
+		if (index[i] < upper[i] && index[i] - base[i] < tile[i] - 1)
+		{
+			//       
+			for (int j = i + 1; j < 4; j++)
+			{
+				offset -= (ptrdiff_t)(index[j] - base[j]) * step[j];
+				index[j] = base[j];
+			}
+			index[i]++;
+			offset += step[i];
+			return true;
+		}
+	for (int i = 3; i >= 0; i--)
+		if (upper[i] - base[i] >= tile[i])
+		{
+			for (int j = i + 1; j < 4; j++)
+				base[j] = lower[j];
+			base[i] += tile[i];
+			first += step[0] * tile[0];
+			offset = first;
+			for (int j = 0; j < 4; j++)
+				index[j] = base[j];
+			return true;
+		}
+	return false;
+}
+
+template<typename T>
+inline T & matrix4_cursor<T, TILED>::getCurrent()
+{
+	return vector[offset];
+}
+
+template<typename T>
+inline int matrix4_cursor<T, TILED>::getIndex(int dimension)
+{
+	return index[dimension - 1];
+}
+
+template<typename T>
+inline ptrdiff_t matrix4_cursor<T, TILED>::getOffset()
+{
+	return offset;
+}
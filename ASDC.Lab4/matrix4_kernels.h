@@ -0,0 +1,306 @@
+#pragma once
+#include "matrix4.h"
+#include "simd_kernels.h"
+
+/// <summary>
+///           <c>float</c>, <c>double</c>, <c>int32_t</c>  <c>int64_t</c>   <see cref="simd_kernels"/>.
+/// </summary>
+/// <remarks>
+///  -      ,   ,     .
+///          ,       ;
+///        ,       
+///     .       (<c>lmatrix4m_layout64</c>, <c>cmatrix4m_layout64</c>),
+///       ,    ;       ,
+///     .   <see cref="lmatrix4"/>, <see cref="cmatrix4"/>     <see cref="matrix4_adapter::getMatrix"/>.
+/// </remarks>
+class matrix4_kernels
+{
+public:
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA, template<typename> class LayoutB>
+	/// <summary>
+	///  <c>result = a operation b</c> .
+	/// </summary>
+	/// <param name='result'> ;    .</param>
+	/// <param name='operation'> .</param>
+	/// <param name='a'> .</param>
+	/// <param name='b'> .</param>
+	/// <exception cref="std::invalid_argument">       .</exception>
+	static void transform(matrix4<T, Layout>& result, BINARY_OPERATION operation, matrix4<T, LayoutA>& a, matrix4<T, LayoutB>& b);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+	/// <summary>
+	///  <c>result = operation(a)</c> .
+	/// </summary>
+	/// <param name='result'> ;    .</param>
+	/// <param name='operation'> .</param>
+	/// <param name='a'>.</param>
+	/// <exception cref="std::invalid_argument">       .</exception>
+	static void transform(matrix4<T, Layout>& result, UNARY_OPERATION operation, matrix4<T, LayoutA>& a);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+	/// <summary>
+	///  <c>result = alpha * a</c> .
+	/// </summary>
+	/// <param name='result'> ;    .</param>
+	/// <param name='alpha'>.</param>
+	/// <param name='a'>.</param>
+	/// <exception cref="std::invalid_argument">       .</exception>
+	static void scale(matrix4<T, Layout>& result, T alpha, matrix4<T, LayoutA>& a);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutX>
+	/// <summary>
+	///  <c>y = alpha * x + y</c> .
+	/// </summary>
+	/// <param name='alpha'>.</param>
+	/// <param name='x'>.</param>
+	/// <param name='y'>   .</param>
+	/// <exception cref="std::invalid_argument">  <paramref name="x"/>     <paramref name="y"/>.</exception>
+	static void axpy(T alpha, matrix4<T, LayoutX>& x, matrix4<T, Layout>& y);
+
+	template<typename T, template<typename> class Layout>
+	/// <summary>
+	///    .
+	/// </summary>
+	/// <param name='a'>.</param>
+	static T sum(matrix4<T, Layout>& a);
+
+	template<typename T, template<typename> class Layout>
+	/// <summary>
+	///    .
+	/// </summary>
+	/// <param name='a'>.</param>
+	static T minimum(matrix4<T, Layout>& a);
+
+	template<typename T, template<typename> class Layout>
+	/// <summary>
+	///    .
+	/// </summary>
+	/// <param name='a'>.</param>
+	static T maximum(matrix4<T, Layout>& a);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutB>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='a'> .</param>
+	/// <param name='b'> .</param>
+	/// <exception cref="std::invalid_argument">    .</exception>
+	static T dot(matrix4<T, Layout>& a, matrix4<T, LayoutB>& b);
+
+private:
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+	static void checkBounds(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a);
+
+	template<typename T, template<typename> class Layout>
+	static size_t getWidth(matrix4<T, Layout>& matrix);
+
+	template<typename T, template<typename> class Layout>
+	static bool isDense(matrix4<T, Layout>& matrix);
+
+	template<typename T, template<typename> class Layout>
+	static T* getFirst(matrix4<T, Layout>& matrix);
+
+	template<typename T, template<typename> class Layout, typename Visitor>
+	static void forEachLine(matrix4<T, Layout>& matrix, Visitor visitor);
+
+	template<typename T, template<typename> class Layout>
+	static const T* getLine(matrix4<T, Layout>& matrix, STORAGE_ORDER order, int i1, int i2, int i3, int i4, size_t width, std::vector<T>& buffer);
+};
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA, template<typename> class LayoutB>
+inline void matrix4_kernels::transform(matrix4<T, Layout>& result, BINARY_OPERATION operation, matrix4<T, LayoutA>& a, matrix4<T, LayoutB>& b)
+{
+	checkBounds(result, a);
+	checkBounds(result, b);
+	const STORAGE_ORDER order = Layout<T>::order;
+	bool ordered = LayoutA<T>::order == order && LayoutB<T>::order == order;
+	if (ordered && isDense(result) && isDense(a) && isDense(b))
+	{
+		simd_kernels<T>::binary(operation, getFirst(a), getFirst(b), getFirst(result), result.getLength());
+		return;
+	}
+	size_t width = getWidth(result);
+	size_t span = ordered && a.getPitch() == result.getPitch() && b.getPitch() == result.getPitch() ? result.getPitch() : width;
+	std::vector<T> bufferA, bufferB;
+	forEachLine(result, [&](int i1, int i2, int i3, int i4)
+	{
+		simd_kernels<T>::binary(operation, getLine(a, order, i1, i2, i3, i4, width, bufferA), getLine(b, order, i1, i2, i3, i4, width, bufferB), &result(i1, i2, i3, i4), span);
+	});
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+inline void matrix4_kernels::transform(matrix4<T, Layout>& result, UNARY_OPERATION operation, matrix4<T, LayoutA>& a)
+{
+	checkBounds(result, a);
+	const STORAGE_ORDER order = Layout<T>::order;
+	bool ordered = LayoutA<T>::order == order;
+	if (ordered && isDense(result) && isDense(a))
+	{
+		simd_kernels<T>::unary(operation, getFirst(a), getFirst(result), result.getLength());
+		return;
+	}
+	size_t width = getWidth(result);
+	size_t span = ordered && a.getPitch() == result.getPitch() ? result.getPitch() : width;
+	std::vector<T> buffer;
+	forEachLine(result, [&](int i1, int i2, int i3, int i4)
+	{
+		simd_kernels<T>::unary(operation, getLine(a, order, i1, i2, i3, i4, width, buffer), &result(i1, i2, i3, i4), span);
+	});
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+inline void matrix4_kernels::scale(matrix4<T, Layout>& result, T alpha, matrix4<T, LayoutA>& a)
+{
+	checkBounds(result, a);
+	const STORAGE_ORDER order = Layout<T>::order;
+	bool ordered = LayoutA<T>::order == order;
+	if (ordered && isDense(result) && isDense(a))
+	{
+		simd_kernels<T>::scale(alpha, getFirst(a), getFirst(result), result.getLength());
+		return;
+	}
+	size_t width = getWidth(result);
+	size_t span = ordered && a.getPitch() == result.getPitch() ? result.getPitch() : width;
+	std::vector<T> buffer;
+	forEachLine(result, [&](int i1, int i2, int i3, int i4)
+	{
+		simd_kernels<T>::scale(alpha, getLine(a, order, i1, i2, i3, i4, width, buffer), &result(i1, i2, i3, i4), span);
+	});
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutX>
+inline void matrix4_kernels::axpy(T alpha, matrix4<T, LayoutX>& x, matrix4<T, Layout>& y)
+{
+	checkBounds(y, x);
+	const STORAGE_ORDER order = Layout<T>::order;
+	bool ordered = LayoutX<T>::order == order;
+	if (ordered && isDense(y) && isDense(x))
+	{
+		simd_kernels<T>::axpy(alpha, getFirst(x), getFirst(y), y.getLength());
+		return;
+	}
+	size_t width = getWidth(y);
+	size_t span = ordered && x.getPitch() == y.getPitch() ? y.getPitch() : width;
+	std::vector<T> buffer;
+	forEachLine(y, [&](int i1, int i2, int i3, int i4)
+	{
+		simd_kernels<T>::axpy(alpha, getLine(x, order, i1, i2, i3, i4, width, buffer), &y(i1, i2, i3, i4), span);
+	});
+}
+
+template<typename T, template<typename> class Layout>
+inline T matrix4_kernels::sum(matrix4<T, Layout>& a)
+{
+	if (isDense(a))
+		return simd_kernels<T>::sum(getFirst(a), a.getLength());
+	size_t width = getWidth(a);
+	T result = 0;
+	forEachLine(a, [&](int i1, int i2, int i3, int i4) { result += simd_kernels<T>::sum(&a(i1, i2, i3, i4), width); });
+	return result;
+}
+
+template<typename T, template<typename> class Layout>
+inline T matrix4_kernels::minimum(matrix4<T, Layout>& a)
+{
+	if (isDense(a))
+		return simd_kernels<T>::minimum(getFirst(a), a.getLength());
+	size_t width = getWidth(a);
+	T result = *getFirst(a);
+	forEachLine(a, [&](int i1, int i2, int i3, int i4)
+	{
+		T line = simd_kernels<T>::minimum(&a(i1, i2, i3, i4), width);
+		result = line < result ? line : result;
+	});
+	return result;
+}
+
+template<typename T, template<typename> class Layout>
+inline T matrix4_kernels::maximum(matrix4<T, Layout>& a)
+{
+	if (isDense(a))
+		return simd_kernels<T>::maximum(getFirst(a), a.getLength());
+	size_t width = getWidth(a);
+	T result = *getFirst(a);
+	forEachLine(a, [&](int i1, int i2, int i3, int i4)
+	{
+		T line = simd_kernels<T>::maximum(&a(i1, i2, i3, i4), width);
+		result = result < line ? line : result;
+	});
+	return result;
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutB>
+inline T matrix4_kernels::dot(matrix4<T, Layout>& a, matrix4<T, LayoutB>& b)
+{
+	checkBounds(a, b);
+	const STORAGE_ORDER order = Layout<T>::order;
+	if (LayoutB<T>::order == order && isDense(a) && isDense(b))
+		return simd_kernels<T>::dot(getFirst(a), getFirst(b), a.getLength());
+	size_t width = getWidth(a);
+	std::vector<T> buffer;
+	T result = 0;
+	forEachLine(a, [&](int i1, int i2, int i3, int i4) { result += simd_kernels<T>::dot(&a(i1, i2, i3, i4), getLine(b, order, i1, i2, i3, i4, width, buffer), width); });
+	return result;
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+inline void matrix4_kernels::checkBounds(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a)
+{
+	for (int dimension = 1; dimension <= 4; dimension++)
+		if (a.getLowerBound(dimension) != result.getLowerBound(dimension) || a.getUpperBound(dimension) != result.getUpperBound(dimension))
+			throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_BOUNDS);
+}
+
+template<typename T, template<typename> class Layout>
+inline size_t matrix4_kernels::getWidth(matrix4<T, Layout>& matrix)
+{
+	static_assert(hasLines(Layout<T>::order), "   ,   .");
+	return (size_t)matrix.getLength(Layout<T>::order == ROW_MAJOR ? 4 : 1);
+}
+
+template<typename T, template<typename> class Layout>
+inline bool matrix4_kernels::isDense(matrix4<T, Layout>& matrix)
+{
+	return matrix.getPitch() == getWidth(matrix);
+}
+
+template<typename T, template<typename> class Layout>
+inline T * matrix4_kernels::getFirst(matrix4<T, Layout>& matrix)
+{
+	return &matrix(matrix.getLowerBound(1), matrix.getLowerBound(2), matrix.getLowerBound(3), matrix.getLowerBound(4));
+}
+
+template<typename T, template<typename> class Layout, typename Visitor>
+inline void matrix4_kernels::forEachLine(matrix4<T, Layout>& matrix, Visitor visitor)
+{
+	// visitor        
+	int l1 = matrix.getLowerBound(1), h1 = matrix.getUpperBound(1);
+	int l2 = matrix.getLowerBound(2), h2 = matrix.getUpperBound(2);
+	int l3 = matrix.getLowerBound(3), h3 = matrix.getUpperBound(3);
+	int l4 = matrix.getLowerBound(4), h4 = matrix.getUpperBound(4);
+	if (Layout<T>::order == ROW_MAJOR)
+	{
+		for (int i1 = l1; i1 <= h1; i1++)
+			for (int i2 = l2; i2 <= h2; i2++)
+				for (int i3 = l3; i3 <= h3; i3++)
+					visitor(i1, i2, i3, l4);
+	}
+	else
+	{
+		for (int i4 = l4; i4 <= h4; i4++)
+			for (int i3 = l3; i3 <= h3; i3++)
+				for (int i2 = l2; i2 <= h2; i2++)
+					visitor(l1, i2, i3, i4);
+	}
+}
+
+template<typename T, template<typename> class Layout>
+inline const T * matrix4_kernels::getLine(matrix4<T, Layout>& matrix, STORAGE_ORDER order, int i1, int i2, int i3, int i4, size_t width, std::vector<T>& buffer)
+{
+	if (Layout<T>::order == order)
+		return &matrix(i1, i2, i3, i4);
+	buffer.resize(width);
+	for (size_t k = 0; k < width; k++)
+		buffer[k] = order == ROW_MAJOR ? matrix(i1, i2, i3, i4 + (int)k) : matrix(i1 + (int)k, i2, i3, i4);
+	return buffer.data();
+}
@@ -0,0 +1,530 @@
+#pragma once
+#include "matrix4.h"
+#include "simd_kernels.h"
+
+/// <summary>
+///  , ,        .
+/// </summary>
+/// <remarks>
+///            :   <c>ROW_MAJOR</c>,   <c>COLUMN_MAJOR</c>.
+///          ( <see cref="ilmatrix4"/>  <see cref="icmatrix4"/>      ),
+///       .   ,      ,      .
+///        ,       .
+///      ,        ,
+///              .
+///      ,   ,      <see cref="MATRIX4_COUNT"/>;
+///    (<c>Z_ORDER</c>  <c>TILED</c>)   <see cref="copy"/>.
+///     .
+/// </remarks>
+class matrix4_parallel
+{
+	friend class matrix4_stencil;
+	friend class citizen_query;
+
+public:
+	template<typename T, template<typename> class Layout>
+	/// <summary>
+	///      .
+	/// </summary>
+	/// <param name='matrix'> .</param>
+	/// <param name='value'> .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	static void fill(matrix4<T, Layout>& matrix, const T& value, unsigned threadCount = 0);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+	/// <summary>
+	///           ;    .
+	/// </summary>
+	/// <remarks>
+	///       .       :
+	///        <see cref="BLOCK_SIZE"/> ,       (  )
+	///   ,      ,  ,   ,     .
+	///           (<c>Z_ORDER</c>  <c>TILED</c>),        .
+	/// </remarks>
+	/// <param name='result'>,    .</param>
+	/// <param name='source'> .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <exception cref="std::invalid_argument">    .</exception>
+	static void copy(matrix4<T, Layout>& result, matrix4<T, LayoutA>& source, unsigned threadCount = 0);
+
+	template<template<typename> class Layout, typename T, template<typename> class LayoutA>
+	/// <summary>
+	///     <typeparamref name="Layout"/>      ,    .
+	/// </summary>
+	/// <param name='source'> .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <returns>    <typeparamref name="Layout"/>.</returns>
+	/// <exception cref="std::bad_alloc">      .</exception>
+	static matrix4<T, Layout> convert(matrix4<T, LayoutA>& source, unsigned threadCount = 0);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA, typename Function>
+	/// <summary>
+	///  <c>result = function(a)</c> .
+	/// </summary>
+	/// <param name='result'> ;    .</param>
+	/// <param name='a'>.</param>
+	/// <param name='function'> <c>T function(const T&amp; a)</c>,     .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <exception cref="std::invalid_argument">       .</exception>
+	static void transform(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a, Function function, unsigned threadCount = 0);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA, template<typename> class LayoutB, typename Function>
+	/// <summary>
+	///  <c>result = function(a, b)</c> .
+	/// </summary>
+	/// <param name='result'> ;    .</param>
+	/// <param name='a'> .</param>
+	/// <param name='b'> .</param>
+	/// <param name='function'> <c>T function(const T&amp; a, const T&amp; b)</c>,     .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <exception cref="std::invalid_argument">       .</exception>
+	static void transform(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a, matrix4<T, LayoutB>& b, Function function, unsigned threadCount = 0);
+
+	template<typename T, template<typename> class Layout, typename Operation>
+	/// <summary>
+	///     .
+	/// </summary>
+	/// <remarks>
+	///         ,   <paramref name="identity"/>,
+	///        ,    <paramref name="identity"/>.
+	/// </remarks>
+	/// <param name='matrix'>.</param>
+	/// <param name='identity'>  .</param>
+	/// <param name='operation'>  <c>T operation(const T&amp; a, const T&amp; b)</c>,     .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <returns> .</returns>
+	static T reduce(matrix4<T, Layout>& matrix, T identity, Operation operation, unsigned threadCount = 0);
+
+	template<typename T, template<typename> class Layout>
+	/// <summary>
+	///       <c>float</c>, <c>double</c>, <c>int32_t</c>  <c>int64_t</c>;    <see cref="simd_kernels::sum"/>.
+	/// </summary>
+	/// <param name='a'>.</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	static T sum(matrix4<T, Layout>& a, unsigned threadCount = 0);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutB>
+	/// <summary>
+	///         ;        <see cref="simd_kernels::dot"/>.
+	/// </summary>
+	/// <param name='a'> .</param>
+	/// <param name='b'> .</param>
+	/// <param name='threadCount'> ; 0    .</param>
+	/// <exception cref="std::invalid_argument">    .</exception>
+	static T dot(matrix4<T, Layout>& a, matrix4<T, LayoutB>& b, unsigned threadCount = 0);
+
+private:
+	template<typename T>
+	/// <summary>
+	///    :          .
+	/// </summary>
+	struct operand
+	{
+		T* first;
+		ptrdiff_t stride[4];
+
+		T* address(const size_t (&offset)[4]) const;
+	};
+
+	/// <summary>
+	///     .
+	/// </summary>
+	struct partition
+	{
+		size_t lines;
+		size_t parts;
+		size_t count;
+	};
+
+	/// <summary>
+	///  ,       .
+	/// </summary>
+	static const size_t PARALLEL_THRESHOLD = 1 << 16;
+
+	/// <summary>
+	///  ,      .
+	/// </summary>
+	static const size_t TASK_COUNT = 256;
+
+	/// <summary>
+	///     ,     ;         .
+	/// </summary>
+	static const size_t BLOCK_SIZE = 16384;
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+	static void transpose(matrix4<T, Layout>& result, matrix4<T, LayoutA>& source, unsigned threadCount);
+
+	template<typename T, STORAGE_ORDER Order>
+	static void transpose(const operand<T>& target, const operand<T>& source, size_t (&lower)[4], size_t (&upper)[4]);
+
+	template<typename T, template<typename> class Layout>
+	static operand<T> getOperand(matrix4<T, Layout>& matrix);
+
+	template<typename T, template<typename> class Layout>
+	static partition getPartition(matrix4<T, Layout>& matrix);
+
+	template<typename T, template<typename> class Layout, typename Visitor>
+	static void forEachLine(matrix4<T, Layout>& matrix, unsigned threadCount, Visitor visitor);
+
+	template<typename Task>
+	static void run(size_t taskCount, unsigned threadCount, Task task);
+
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+	static void checkBounds(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a);
+};
+
+template<typename T, template<typename> class Layout>
+inline void matrix4_parallel::fill(matrix4<T, Layout>& matrix, const T & value, unsigned threadCount)
+{
+	operand<T> target = getOperand(matrix);
+	size_t width = (size_t)matrix.getLength(Layout<T>::order == ROW_MAJOR ? 4 : 1);
+	forEachLine(matrix, threadCount, [&](size_t, const size_t (&offset)[4])
+	{
+		T* line = target.address(offset);
+		for (size_t k = 0; k < width; k++)
+			line[k] = value;
+	});
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+inline void matrix4_parallel::copy(matrix4<T, Layout>& result, matrix4<T, LayoutA>& source, unsigned threadCount)
+{
+	if constexpr (!hasLines(Layout<T>::order) || !hasLines(LayoutA<T>::order))
+	{
+		//        :       ,    
+		checkBounds(result, source);
+		result.forEach([&source](T& item, int i1, int i2, int i3, int i4) { item = source(i1, i2, i3, i4); });
+	}
+	else if (LayoutA<T>::order == Layout<T>::order)
+		transform(result, source, [](const T& a) -> const T& { return a; }, threadCount);
+	else
+		transpose(result, source, threadCount);
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+inline void matrix4_parallel::transpose(matrix4<T, Layout>& result, matrix4<T, LayoutA>& source, unsigned threadCount)
+{
+	checkBounds(result, source);
+	operand<T> target = getOperand(result), x = getOperand(source);
+
+	//    :          
+	// (    ),            
+	int slow = Layout<T>::order == ROW_MAJOR ? 0 : 3, next = Layout<T>::order == ROW_MAJOR ? 1 : 2;
+	size_t extent[4];
+	for (int d = 0; d < 4; d++)
+		extent[d] = (size_t)result.getLength(d + 1);
+	size_t width = (extent[slow] + TASK_COUNT - 1) / TASK_COUNT;
+	if (width < CACHE_LINE_SIZE / sizeof(T))
+		width = CACHE_LINE_SIZE / sizeof(T) > 0 ? CACHE_LINE_SIZE / sizeof(T) : 1;
+	size_t chunks = (extent[slow] + width - 1) / width;
+	size_t parts = chunks >= TASK_COUNT ? 1 : (TASK_COUNT + chunks - 1) / chunks;
+	if (parts > extent[next])
+		parts = extent[next];
+	if (result.getLength() < PARALLEL_THRESHOLD)
+		threadCount = 1;
+	run(chunks * parts, threadCount, [&](size_t task)
+	{
+		size_t chunk = task / parts, part = task % parts;
+		size_t lower[4] = { 0, 0, 0, 0 };
+		size_t upper[4] = { extent[0], extent[1], extent[2], extent[3] };
+		lower[slow] = chunk * width;
+		upper[slow] = lower[slow] + width < extent[slow] ? lower[slow] + width : extent[slow];
+		lower[next] = part * extent[next] / parts;
+		upper[next] = (part + 1) * extent[next] / parts;
+		transpose<T, Layout<T>::order>(target, x, lower, upper);
+	});
+}
+
+template<template<typename> class Layout, typename T, template<typename> class LayoutA>
+inline matrix4<T, Layout> matrix4_parallel::convert(matrix4<T, LayoutA>& source, unsigned threadCount)
+{
+	matrix4<T, Layout> result(source.getLowerBound(1), source.getUpperBound(1), source.getLowerBound(2), source.getUpperBound(2),
+		source.getLowerBound(3), source.getUpperBound(3), source.getLowerBound(4), source.getUpperBound(4), DEFAULT_INITIALIZATION);
+	copy(result, source, threadCount);
+	return result;
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA, typename Function>
+inline void matrix4_parallel::transform(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a, Function function, unsigned threadCount)
+{
+	checkBounds(result, a);
+	operand<T> target = getOperand(result), x = getOperand(a);
+	int fast = Layout<T>::order == ROW_MAJOR ? 3 : 0;
+	size_t width = (size_t)result.getLength(fast + 1);
+	ptrdiff_t step = x.stride[fast];
+	forEachLine(result, threadCount, [&](size_t, const size_t (&offset)[4])
+	{
+		T* line = target.address(offset);
+		const T* lineA = x.address(offset);
+		for (size_t k = 0; k < width; k++)
+			line[k] = function(lineA[(ptrdiff_t)k * step]);
+	});
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA, template<typename> class LayoutB, typename Function>
+inline void matrix4_parallel::transform(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a, matrix4<T, LayoutB>& b, Function function, unsigned threadCount)
+{
+	checkBounds(result, a);
+	checkBounds(result, b);
+	operand<T> target = getOperand(result), x = getOperand(a), y = getOperand(b);
+	int fast = Layout<T>::order == ROW_MAJOR ? 3 : 0;
+	size_t width = (size_t)result.getLength(fast + 1);
+	ptrdiff_t stepA = x.stride[fast], stepB = y.stride[fast];
+	forEachLine(result, threadCount, [&](size_t, const size_t (&offset)[4])
+	{
+		T* line = target.address(offset);
+		const T* lineA = x.address(offset);
+		const T* lineB = y.address(offset);
+		for (size_t k = 0; k < width; k++)
+			line[k] = function(lineA[(ptrdiff_t)k * stepA], lineB[(ptrdiff_t)k * stepB]);
+	});
+}
+
+template<typename T, template<typename> class Layout, typename Operation>
+inline T matrix4_parallel::reduce(matrix4<T, Layout>& matrix, T identity, Operation operation, unsigned threadCount)
+{
+	operand<T> source = getOperand(matrix);
+	size_t width = (size_t)matrix.getLength(Layout<T>::order == ROW_MAJOR ? 4 : 1);
+	std::vector<T> partial(getPartition(matrix).count, identity);
+	forEachLine(matrix, threadCount, [&](size_t task, const size_t (&offset)[4])
+	{
+		const T* line = source.address(offset);
+		T value = partial[task];
+		for (size_t k = 0; k < width; k++)
+			value = operation(value, line[k]);
+		partial[task] = value;
+	});
+	T result = identity;
+	for (const T& value : partial)
+		result = operation(result, value);
+	return result;
+}
+
+template<typename T, template<typename> class Layout>
+inline T matrix4_parallel::sum(matrix4<T, Layout>& a, unsigned threadCount)
+{
+	operand<T> source = getOperand(a);
+	size_t width = (size_t)a.getLength(Layout<T>::order == ROW_MAJOR ? 4 : 1);
+	std::vector<T> partial(getPartition(a).count, T());
+	forEachLine(a, threadCount, [&](size_t task, const size_t (&offset)[4])
+	{
+		partial[task] += simd_kernels<T>::sum(source.address(offset), width);
+	});
+	T result = T();
+	for (const T& value : partial)
+		result += value;
+	return result;
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutB>
+inline T matrix4_parallel::dot(matrix4<T, Layout>& a, matrix4<T, LayoutB>& b, unsigned threadCount)
+{
+	checkBounds(a, b);
+	operand<T> x = getOperand(a), y = getOperand(b);
+	int fast = Layout<T>::order == ROW_MAJOR ? 3 : 0;
+	size_t width = (size_t)a.getLength(fast + 1);
+	ptrdiff_t step = y.stride[fast];
+	std::vector<T> partial(getPartition(a).count, T());
+	forEachLine(a, threadCount, [&](size_t task, const size_t (&offset)[4])
+	{
+		const T* lineA = x.address(offset);
+		const T* lineB = y.address(offset);
+		if (step == 1)
+			partial[task] += simd_kernels<T>::dot(lineA, lineB, width);
+		else
+		{
+			T value = T();
+			for (size_t k = 0; k < width; k++)
+				value += lineA[k] * lineB[(ptrdiff_t)k * step];
+			partial[task] += value;
+		}
+	});
+	T result = T();
+	for (const T& value : partial)
+		result += value;
+	return result;
+}
+
+template<typename T>
+inline T * matrix4_parallel::operand<T>::address(const size_t (&offset)[4]) const
+{
+	return first + (ptrdiff_t)offset[0] * stride[0] + (ptrdiff_t)offset[1] * stride[1] + (ptrdiff_t)offset[2] * stride[2] + (ptrdiff_t)offset[3] * stride[3];
+}
+
+template<typename T, template<typename> class Layout>
+inline matrix4_parallel::operand<T> matrix4_parallel::getOperand(matrix4<T, Layout>& matrix)
+{
+	//           getPitch   ,   
+	static_assert(hasLines(Layout<T>::order), "      copy.");
+	operand<T> result;
+	result.first = &matrix(matrix.getLowerBound(1), matrix.getLowerBound(2), matrix.getLowerBound(3), matrix.getLowerBound(4));
+	ptrdiff_t pitch = (ptrdiff_t)matrix.getPitch();
+	if (Layout<T>::order == ROW_MAJOR)
+	{
+		result.stride[3] = 1;
+		result.stride[2] = pitch;
+		result.stride[1] = pitch * matrix.getLength(3);
+		result.stride[0] = result.stride[1] * matrix.getLength(2);
+	}
+	else
+	{
+		result.stride[0] = 1;
+		result.stride[1] = pitch;
+		result.stride[2] = pitch * matrix.getLength(2);
+		result.stride[3] = result.stride[2] * matrix.getLength(3);
+	}
+	return result;
+}
+
+template<typename T, template<typename> class Layout>
+inline matrix4_parallel::partition matrix4_parallel::getPartition(matrix4<T, Layout>& matrix)
+{
+	//      ,       
+	partition result;
+	size_t slabs = (size_t)matrix.getLength(Layout<T>::order == ROW_MAJOR ? 1 : 4);
+	result.lines = (size_t)matrix.getLength(2) * (size_t)matrix.getLength(3);
+	result.parts = slabs >= TASK_COUNT ? 1 : (TASK_COUNT + slabs - 1) / slabs;
+	if (result.parts > result.lines)
+		result.parts = result.lines;
+	result.count = slabs * result.parts;
+	return result;
+}
+
+template<typename T, template<typename> class Layout, typename Visitor>
+inline void matrix4_parallel::forEachLine(matrix4<T, Layout>& matrix, unsigned threadCount, Visitor visitor)
+{
+	// visitor            
+	partition tasks = getPartition(matrix);
+	size_t length2 = (size_t)matrix.getLength(2), length3 = (size_t)matrix.getLength(3);
+	if (matrix.getLength() < PARALLEL_THRESHOLD)
+		threadCount = 1;
+	run(tasks.count, threadCount, [&](size_t task)
+	{
+		size_t slab = task / tasks.parts, part = task % tasks.parts;
+		size_t first = part * tasks.lines / tasks.parts, last = (part + 1) * tasks.lines / tasks.parts;
+		size_t offset[4] = { 0, 0, 0, 0 };
+		for (size_t line = first; line < last; line++)
+		{
+			if (Layout<T>::order == ROW_MAJOR)
+			{
+				offset[0] = slab;
+				offset[1] = line / length3;
+				offset[2] = line % length3;
+			}
+			else
+			{
+				offset[3] = slab;
+				offset[2] = line / length2;
+				offset[1] = line % length2;
+			}
+			visitor(task, offset);
+		}
+	});
+}
+
+template<typename Task>
+inline void matrix4_parallel::run(size_t taskCount, unsigned threadCount, Task task)
+{
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0)
+		threadCount = 1;
+	if (threadCount > taskCount)
+		threadCount = (unsigned)taskCount;
+	if (threadCount <= 1)
+	{
+		for (size_t t = 0; t < taskCount; t++)
+			task(t);
+		return;
+	}
+
+	//      ;       
+	std::atomic<size_t> next(0);
+	std::vector<std::exception_ptr> errors(threadCount);
+	auto worker = [&](unsigned w)
+	{
+		try
+		{
+			for (size_t t = next++; t < taskCount; t = next++)
+				task(t);
+		}
+		catch (...)
+		{
+			errors[w] = std::current_exception();
+			next = taskCount;
+		}
+	};
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	try
+	{
+		for (unsigned w = 1; w < threadCount; w++)
+			threads.emplace_back(worker, w);
+	}
+	catch (...)
+	{
+		next = taskCount;
+		for (std::thread& thread : threads)
+			thread.join();
+		throw;
+	}
+	worker(0);
+	for (std::thread& thread : threads)
+		thread.join();
+	for (std::exception_ptr& error : errors)
+		if (error)
+			std::rethrow_exception(error);
+}
+
+template<typename T, STORAGE_ORDER Order>
+inline void matrix4_parallel::transpose(const operand<T>& target, const operand<T>& source, size_t (&lower)[4], size_t (&upper)[4])
+{
+	size_t extent[4], count = 1;
+	for (int d = 0; d < 4; d++)
+	{
+		extent[d] = upper[d] - lower[d];
+		count *= extent[d];
+	}
+	if (count * sizeof(T) > BLOCK_SIZE && count > 1)
+	{
+		//       ,   ,     
+		int split;
+		if ((extent[0] * extent[3] * sizeof(T) >= BLOCK_SIZE && extent[0] * extent[3] > 1) || (extent[1] <= 1 && extent[2] <= 1))
+			split = extent[0] >= extent[3] ? 0 : 3;
+		else
+			split = extent[1] >= extent[2] ? 1 : 2;
+		size_t middle = lower[split] + extent[split] / 2, bound = upper[split];
+		upper[split] = middle;
+		transpose<T, Order>(target, source, lower, upper);
+		upper[split] = bound;
+		bound = lower[split];
+		lower[split] = middle;
+		transpose<T, Order>(target, source, lower, upper);
+		lower[split] = bound;
+		return;
+	}
+
+	//      ;       
+	int fast = Order == ROW_MAJOR ? 3 : 0;
+	int outer = Order == ROW_MAJOR ? 0 : 3, middle = Order == ROW_MAJOR ? 1 : 2, inner = Order == ROW_MAJOR ? 2 : 1;
+	ptrdiff_t step = source.stride[fast];
+	size_t offset[4];
+	offset[fast] = lower[fast];
+	for (offset[outer] = lower[outer]; offset[outer] < upper[outer]; offset[outer]++)
+		for (offset[middle] = lower[middle]; offset[middle] < upper[middle]; offset[middle]++)
+			for (offset[inner] = lower[inner]; offset[inner] < upper[inner]; offset[inner]++)
+			{
+				T* line = target.address(offset);
+				const T* from = source.address(offset);
+				for (size_t k = 0; k < extent[fast]; k++)
+					line[k] = from[(ptrdiff_t)k * step];
+			}
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+inline void matrix4_parallel::checkBounds(matrix4<T, Layout>& result, matrix4<T, LayoutA>& a)
+{
+	for (int dimension = 1; dimension <= 4; dimension++)
+		if (a.getLowerBound(dimension) != result.getLowerBound(dimension) || a.getUpperBound(dimension) != result.getUpperBound(dimension))
+			throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_BOUNDS);
+}
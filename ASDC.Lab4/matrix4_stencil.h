@@ -0,0 +1,330 @@
+#pragma once
+#include "matrix4_parallel.h"
+#include "simd_kernels.h"
+
+/// <summary>
+/// ,    ,    .
+/// </summary>
+/// <remarks>
+/// <c>BOUNDARY_CLAMP</c>      , <c>BOUNDARY_SKIP</c>    ,
+/// <c>BOUNDARY_PERIODIC</c>   ,       .
+/// </remarks>
+enum STENCIL_BOUNDARY : int
+{
+	BOUNDARY_CLAMP, BOUNDARY_SKIP, BOUNDARY_PERIODIC
+};
+
+/// <summary>
+/// ,    ,    .
+/// </summary>
+/// <remarks>
+/// <c>STENCIL_SUM</c>   ,     , <c>STENCIL_AVERAGE</c>       ;
+/// <c>STENCIL_MINIMUM</c>  <c>STENCIL_MAXIMUM</c>   .
+/// </remarks>
+enum STENCIL_OPERATION : int
+{
+	STENCIL_SUM, STENCIL_AVERAGE, STENCIL_MINIMUM, STENCIL_MAXIMUM
+};
+
+template<typename T>
+/// <summary>
+///    :          .
+/// </summary>
+class stencil4
+{
+	struct entry
+	{
+		int offset[4];
+		T weight;
+	};
+
+	std::vector<entry> points;
+
+public:
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='d1'>  .</param>
+	/// <param name='d2'>  .</param>
+	/// <param name='d3'>  .</param>
+	/// <param name='d4'>  .</param>
+	/// <param name='weight'>   .</param>
+	void add(int d1, int d2, int d3, int d4, T weight = 1);
+
+	/// <summary>
+	///    .
+	/// </summary>
+	size_t getCount() const;
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='point'>    ,   .</param>
+	/// <param name='dimension'> ,     .</param>
+	/// <exception cref="std::out_of_range">       <paramref name="dimension"/>  1   4.</exception>
+	int getOffset(size_t point, int dimension) const;
+
+	/// <summary>
+	///    .
+	/// </summary>
+	/// <param name='point'>    ,   .</param>
+	/// <exception cref="std::out_of_range">    .</exception>
+	T getWeight(size_t point) const;
+
+	/// <summary>
+	///        ,       ,   .
+	/// </summary>
+	static stencil4 getNeighborhood();
+
+	/// <summary>
+	///          <c>2 * radius + 1</c>       .
+	/// </summary>
+	/// <param name='radius'>   .</param>
+	static stencil4 getBox(int radius);
+};
+
+/// <summary>
+///       <see cref="stencil4"/>:           .
+/// </summary>
+/// <remarks>
+///       ,    ,   <see cref="matrix4_parallel"/>.
+///                   ,
+///    ,     ,   <see cref="simd_kernels"/>,      .
+///       <see cref="BLOCK_LENGTH"/> ,      ,       .
+///         ,     <see cref="matrix4::at"/>.
+///   <c>float</c>, <c>double</c>, <c>int32_t</c>  <c>int64_t</c>;      .
+/// </remarks>
+class matrix4_stencil
+{
+public:
+	template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <remarks>
+	///          (<c>ROW_MAJOR</c>  <c>COLUMN_MAJOR</c>),     .
+	///   <c>BOUNDARY_SKIP</c>        ,   ,   ,
+	///            <typeparamref name="T"/>.
+	/// </remarks>
+	/// <param name='result'>,    .</param>
+	/// <param name='source'> .</param>
+	/// <param name='stencil'> .</param>
+	/// <param name='operation'>   .</param>
+	/// <param name='boundary'>      .</param>
+	/// <param name='threadCount'> ; 0     .</param>
+	/// <exception cref="std::invalid_argument">
+	///     .
+	/// - -
+	///      .
+	/// - -
+	///     .
+	/// </exception>
+	static void apply(matrix4<T, Layout>& result, matrix4<T, LayoutA>& source, const stencil4<T>& stencil, STENCIL_OPERATION operation, STENCIL_BOUNDARY boundary, unsigned threadCount = 0);
+
+private:
+	/// <summary>
+	///    ,     ,     .
+	/// </summary>
+	static const size_t BLOCK_LENGTH = 1024;
+
+	static ptrdiff_t getIndex(ptrdiff_t index, ptrdiff_t length, STENCIL_BOUNDARY boundary);
+
+	template<typename T>
+	static void initialize(T* line, size_t length, STENCIL_OPERATION operation);
+
+	template<typename T>
+	static void combine(T* line, const T* source, size_t length, T weight, STENCIL_OPERATION operation);
+
+	template<typename T>
+	static T combine(T accumulated, T value, T weight, STENCIL_OPERATION operation);
+};
+
+template<typename T>
+inline void stencil4<T>::add(int d1, int d2, int d3, int d4, T weight)
+{
+	points.push_back({ { d1, d2, d3, d4 }, weight });
+}
+
+template<typename T>
+inline size_t stencil4<T>::getCount() const
+{
+	return points.size();
+}
+
+template<typename T>
+inline int stencil4<T>::getOffset(size_t point, int dimension) const
+{
+	if (dimension < 1 || dimension > 4)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_DIMENSION);
+	return points.at(point).offset[dimension - 1];
+}
+
+template<typename T>
+inline T stencil4<T>::getWeight(size_t point) const
+{
+	return points.at(point).weight;
+}
+
+template<typename T>
+inline stencil4<T> stencil4<T>::getNeighborhood()
+{
+	stencil4 result;
+	result.add(0, 0, 0, 0);
+	for (int d = 0; d < 4; d++)
+		for (int shift = -1; shift <= 1; shift += 2)
+			result.add(d == 0 ? shift : 0, d == 1 ? shift : 0, d == 2 ? shift : 0, d == 3 ? shift : 0);
+	return result;
+}
+
+template<typename T>
+inline stencil4<T> stencil4<T>::getBox(int radius)
+{
+	stencil4 result;
+	for (int d1 = -radius; d1 <= radius; d1++)
+		for (int d2 = -radius; d2 <= radius; d2++)
+			for (int d3 = -radius; d3 <= radius; d3++)
+				for (int d4 = -radius; d4 <= radius; d4++)
+					result.add(d1, d2, d3, d4);
+	return result;
+}
+
+template<typename T, template<typename> class Layout, template<typename> class LayoutA>
+inline void matrix4_stencil::apply(matrix4<T, Layout>& result, matrix4<T, LayoutA>& source, const stencil4<T>& stencil, STENCIL_OPERATION operation, STENCIL_BOUNDARY boundary, unsigned threadCount)
+{
+	static_assert(hasLines(Layout<T>::order) && LayoutA<T>::order == Layout<T>::order, "       .");
+	matrix4_parallel::checkBounds(result, source);
+	size_t count = stencil.getCount();
+	if (count == 0)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_STENCIL);
+	matrix4_parallel::operand<T> target = matrix4_parallel::getOperand(result), x = matrix4_parallel::getOperand(source);
+	if (target.first == x.first)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_ALIAS);
+
+	int fast = Layout<T>::order == ROW_MAJOR ? 3 : 0;
+	ptrdiff_t extent[4];
+	for (int d = 0; d < 4; d++)
+		extent[d] = (ptrdiff_t)result.getLength(d + 1);
+	std::vector<int> offsets(count * 4);
+	std::vector<T> weights(count);
+	T total = 0;
+	for (size_t p = 0; p < count; p++)
+	{
+		for (int d = 0; d < 4; d++)
+			offsets[p * 4 + d] = stencil.getOffset(p, d + 1);
+		weights[p] = stencil.getWeight(p);
+		total += weights[p];
+	}
+	bool counted = operation == STENCIL_AVERAGE && boundary == BOUNDARY_SKIP;
+
+	matrix4_parallel::forEachLine(result, threadCount, [&](size_t, const size_t (&offset)[4])
+	{
+		T* line = target.address(offset);
+		T weight[BLOCK_LENGTH];
+		for (ptrdiff_t first = 0; first < extent[fast]; first += (ptrdiff_t)BLOCK_LENGTH)
+		{
+			ptrdiff_t last = first + (ptrdiff_t)BLOCK_LENGTH < extent[fast] ? first + (ptrdiff_t)BLOCK_LENGTH : extent[fast];
+			initialize(line + first, (size_t)(last - first), operation);
+			if (counted)
+				for (ptrdiff_t j = first; j < last; j++)
+					weight[j - first] = 0;
+			for (size_t p = 0; p < count; p++)
+			{
+				//        ;  BOUNDARY_SKIP       
+				const int* shift = &offsets[p * 4];
+				const T* row = x.first;
+				bool inside = true;
+				for (int d = 0; d < 4 && inside; d++)
+					if (d != fast)
+					{
+						ptrdiff_t k = getIndex((ptrdiff_t)offset[d] + shift[d], extent[d], boundary);
+						inside = k >= 0;
+						row += k * x.stride[d];
+					}
+				if (!inside)
+					continue;
+
+				//  [lower, upper)       ;     
+				ptrdiff_t o = shift[fast];
+				ptrdiff_t lower = -o > first ? (-o < last ? -o : last) : first;
+				ptrdiff_t upper = extent[fast] - o < last ? extent[fast] - o : last;
+				if (upper < lower)
+					upper = lower;
+				if (upper > lower)
+					combine(line + lower, row + lower + o, (size_t)(upper - lower), weights[p], operation);
+				if (counted)
+					for (ptrdiff_t j = lower; j < upper; j++)
+						weight[j - first] += weights[p];
+				for (ptrdiff_t j = lower > first ? first : upper; j < last; j = j + 1 == lower ? upper : j + 1)
+				{
+					ptrdiff_t k = getIndex(j + o, extent[fast], boundary);
+					if (k < 0)
+						continue;
+					line[j] = combine(line[j], row[k], weights[p], operation);
+					if (counted)
+						weight[j - first] += weights[p];
+				}
+			}
+			if (operation == STENCIL_AVERAGE)
+				for (ptrdiff_t j = first; j < last; j++)
+				{
+					T divisor = counted ? weight[j - first] : total;
+					line[j] = divisor != 0 ? line[j] / divisor : 0;
+				}
+		}
+	});
+}
+
+inline ptrdiff_t matrix4_stencil::getIndex(ptrdiff_t index, ptrdiff_t length, STENCIL_BOUNDARY boundary)
+{
+	if (index >= 0 && index < length)
+		return index;
+	switch (boundary)
+	{
+	case BOUNDARY_CLAMP:
+		return index < 0 ? 0 : length - 1;
+	case BOUNDARY_PERIODIC:
+		index %= length;
+		return index < 0 ? index + length : index;
+	default:
+		return -1;
+	}
+}
+
+template<typename T>
+inline void matrix4_stencil::initialize(T * line, size_t length, STENCIL_OPERATION operation)
+{
+	T value = operation == STENCIL_MINIMUM ? (std::numeric_limits<T>::max)() : operation == STENCIL_MAXIMUM ? std::numeric_limits<T>::lowest() : 0;
+	for (size_t k = 0; k < length; k++)
+		line[k] = value;
+}
+
+template<typename T>
+inline void matrix4_stencil::combine(T * line, const T * source, size_t length, T weight, STENCIL_OPERATION operation)
+{
+	switch (operation)
+	{
+	case STENCIL_MINIMUM:
+		simd_kernels<T>::binary(BINARY_MINIMUM, line, source, line, length);
+		break;
+	case STENCIL_MAXIMUM:
+		simd_kernels<T>::binary(BINARY_MAXIMUM, line, source, line, length);
+		break;
+	default:
+		simd_kernels<T>::axpy(weight, source, line, length);
+		break;
+	}
+}
+
+template<typename T>
+inline T matrix4_stencil::combine(T accumulated, T value, T weight, STENCIL_OPERATION operation)
+{
+	switch (operation)
+	{
+	case STENCIL_MINIMUM:
+		return value < accumulated ? value : accumulated;
+	case STENCIL_MAXIMUM:
+		return accumulated < value ? value : accumulated;
+	default:
+		return accumulated + weight * value;
+	}
+}
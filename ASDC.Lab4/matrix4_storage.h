@@ -0,0 +1,265 @@
+#pragma once
+
+/// <summary>
+///   ,           <c>lmatrix4m_layout64</c>  <c>cmatrix4m_layout64</c>.
+/// </summary>
+#define CACHE_LINE_SIZE 64
+
+/// <summary>
+/// ,    ,      .
+/// </summary>
+/// <remarks>
+/// <c>DEFAULT_INITIALIZATION</c>   <c>new T</c>:        ,
+///     . <c>VALUE_INITIALIZATION</c>  <c>new T()</c>    .
+/// </remarks>
+enum ELEMENT_INITIALIZATION : int
+{
+	DEFAULT_INITIALIZATION, VALUE_INITIALIZATION
+};
+
+template<typename T>
+/// <summary>
+///    <see cref="matrix4"/>:   ,        ,   .
+/// </summary>
+/// <remarks>
+///            ,  ,  ,   .
+///    ,        <see cref="setOwner"/>.
+///    ,   ,    ,     .
+/// </remarks>
+class matrix4_storage
+{
+	T* vector;
+	size_t count;
+	void* owner;
+	void (*release)(T* vector, size_t count, void* owner);
+
+public:
+	/// <summary>
+	///    <see cref="matrix4_storage"/>,       .
+	/// </summary>
+	/// <param name='capacity'> ,    .</param>
+	/// <param name='alignment'>  ,     ;   <c>alignof(T)</c>.</param>
+	/// <exception cref="std::bad_alloc">      .</exception>
+	matrix4_storage(size_t capacity, size_t alignment);
+
+	/// <summary>
+	///    <see cref="matrix4_storage"/>   ,     .
+	/// </summary>
+	/// <param name='vector'>  .</param>
+	/// <param name='release'>,     ,  <see cref="releaseExternal"/>.</param>
+	matrix4_storage(T* vector, void (*release)(T* vector, size_t count, void* owner));
+
+	matrix4_storage(const matrix4_storage&) = delete;
+
+	matrix4_storage& operator=(const matrix4_storage&) = delete;
+
+	/// <summary>
+	///    <see cref="matrix4_storage"/>,    .
+	/// </summary>
+	/// <param name='other'>,    .</param>
+	matrix4_storage(matrix4_storage&& other);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='other'>,    .</param>
+	/// <returns>   .</returns>
+	matrix4_storage& operator=(matrix4_storage&& other);
+
+	/// <summary>
+	///      .
+	/// </summary>
+	~matrix4_storage();
+
+	/// <summary>
+	///      .
+	/// </summary>
+	T* getVector() const;
+
+	/// <summary>
+	///   ,     .
+	/// </summary>
+	size_t getCount() const;
+
+	/// <summary>
+	///       ,      .
+	/// </summary>
+	/// <param name='release'>,     .</param>
+	/// <param name='owner'>,   ,  <c>std::vector&lt;T&gt;*</c>,  nullptr.</param>
+	void setOwner(void (*release)(T* vector, size_t count, void* owner), void* owner);
+
+	template<typename Source>
+	/// <summary>
+	///    ,    ,      .
+	/// </summary>
+	/// <param name='total'>   .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,       <c>new</c>.</param>
+	void construct(size_t total, Source source);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='total'>   .</param>
+	/// <param name='initialization'>  .</param>
+	void fill(size_t total, ELEMENT_INITIALIZATION initialization);
+
+	/// <summary>
+	///    ,    ,       .
+	/// </summary>
+	/// <param name='length'>  .</param>
+	/// <param name='alignment'>   .</param>
+	/// <returns>     .</returns>
+	static size_t getPitch(size_t length, size_t alignment);
+
+	/// <summary>
+	///      ,  .
+	/// </summary>
+	static void releaseOwned(T* vector, size_t count, void* owner);
+
+	/// <summary>
+	///  ,   <c>new T[]</c>.
+	/// </summary>
+	static void releaseArray(T* vector, size_t count, void* owner);
+
+	/// <summary>
+	///  <c>std::vector&lt;T&gt;</c>,    .
+	/// </summary>
+	static void releaseVector(T* vector, size_t count, void* owner);
+
+	/// <summary>
+	///    .
+	/// </summary>
+	static void releaseExternal(T* vector, size_t count, void* owner);
+};
+
+template<typename T>
+inline matrix4_storage<T>::matrix4_storage(size_t capacity, size_t alignment) : vector(nullptr), count(0), owner(nullptr), release(releaseOwned)
+{
+	if (capacity > SIZE_MAX / sizeof(T))
+		throw std::bad_alloc();
+	vector = (T*)_aligned_malloc(capacity * sizeof(T), alignment);
+	if (vector == nullptr)
+		throw std::bad_alloc();
+}
+
+template<typename T>
+inline matrix4_storage<T>::matrix4_storage(T * vector, void (*release)(T*, size_t, void*)) : vector(vector), count(0), owner(nullptr), release(release)
+{
+}
+
+template<typename T>
+inline matrix4_storage<T>::matrix4_storage(matrix4_storage && other) : vector(other.vector), count(other.count), owner(other.owner), release(other.release)
+{
+	other.vector = nullptr;
+	other.count = 0;
+	other.owner = nullptr;
+}
+
+template<typename T>
+inline matrix4_storage<T> & matrix4_storage<T>::operator=(matrix4_storage && other)
+{
+	if (this != &other)
+	{
+		release(vector, count, owner);
+		vector = other.vector;
+		count = other.count;
+		owner = other.owner;
+		release = other.release;
+		other.vector = nullptr;
+		other.count = 0;
+		other.owner = nullptr;
+	}
+	return *this;
+}
+
+template<typename T>
+inline matrix4_storage<T>::~matrix4_storage()
+{
+	release(vector, count, owner);
+}
+
+template<typename T>
+inline T * matrix4_storage<T>::getVector() const
+{
+	return vector;
+}
+
+template<typename T>
+inline size_t matrix4_storage<T>::getCount() const
+{
+	return count;
+}
+
+template<typename T>
+inline void matrix4_storage<T>::setOwner(void (*release)(T*, size_t, void*), void * owner)
+{
+	this->release = release;
+	this->owner = owner;
+}
+
+template<typename T>
+template<typename Source>
+inline void matrix4_storage<T>::construct(size_t total, Source source)
+{
+	while (count < total && source(vector + count))
+		count++;
+}
+
+template<typename T>
+inline void matrix4_storage<T>::fill(size_t total, ELEMENT_INITIALIZATION initialization)
+{
+	if (initialization == DEFAULT_INITIALIZATION)
+	{
+		//         ,     
+		if (std::is_trivially_default_constructible<T>::value)
+			count = total;
+		for (; count < total; count++)
+			new (vector + count) T;
+	}
+	else
+	{
+		for (; count < total; count++)
+			new (vector + count) T();
+	}
+}
+
+template<typename T>
+inline size_t matrix4_storage<T>::getPitch(size_t length, size_t alignment)
+{
+	//   step     ;    step = alignment / sizeof(T)
+	size_t a = alignment, b = sizeof(T);
+	while (b != 0)
+	{
+		size_t r = a % b;
+		a = b;
+		b = r;
+	}
+	size_t step = alignment / a;
+	return (length + step - 1) / step * step;
+}
+
+template<typename T>
+inline void matrix4_storage<T>::releaseOwned(T * vector, size_t count, void *)
+{
+	if (!std::is_trivially_destructible<T>::value)
+		for (size_t i = 0; i < count; i++)
+			vector[i].~T();
+	_aligned_free(vector);
+}
+
+template<typename T>
+inline void matrix4_storage<T>::releaseArray(T * vector, size_t, void *)
+{
+	delete[] vector;
+}
+
+template<typename T>
+inline void matrix4_storage<T>::releaseVector(T *, size_t, void * owner)
+{
+	delete (std::vector<T>*)owner;
+}
+
+template<typename T>
+inline void matrix4_storage<T>::releaseExternal(T *, size_t, void *)
+{
+}
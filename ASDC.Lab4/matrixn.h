@@ -0,0 +1,798 @@
+#pragma once
+#include "resource.h"
+#include "storage_order.h"
+#include "matrix4_cursor.h"
+#include "address_counter.h"
+#include "matrix4_storage.h"
+
+/// <summary>
+///   ,       - <see cref="matrixN"/>,       ,
+///      :    ,    .
+/// </summary>
+class matrixN_no_index
+{
+	matrixN_no_index();
+};
+
+template<typename T, int N, template<typename> class Layout>
+/// <summary>
+///    N-  ,   ,        <typeparamref name="Layout"/>.
+/// </summary>
+/// <remarks>
+///     <c>std::array</c>,    <see cref="at"/>  <c>operator()</c>   <typeparamref name="N"/> ,
+///            .
+///  - ,        .
+///  <typeparamref name="Layout"/>    <c>Layout(const std::array&lt;std::array&lt;int, 2&gt;, N&gt;&amp; index, T* vector)</c>,
+///  <c>T* address(T* vector, Index... i) const</c>  <typeparamref name="N"/> ,  <c>getAddCount</c>, <c>getMulCount</c>
+///  <c>getIndirectionCount</c>    ,      ,     <c>order</c>,      ,  <c>alignment</c>    ,
+///          ;       (<see cref="matrix4_storage::getPitch"/>),
+///  <see cref="getLength"/>, , <see cref="forEach"/>  <see cref="getCursor"/>    .
+///   <see cref="counted_layout"/>      <see cref="MATRIX4_COUNT"/>,
+///       ;       .
+///     ,    <c>std::unique_ptr&lt;T[]&gt;</c>  <c>std::vector&lt;T&gt;</c>
+///    (<see cref="wrap"/>);      .
+///     (<see cref="matrix4_storage"/>),         :
+///       ,   ,    <see cref="emplace"/>.
+///      <see cref="matrix4"/>.       ,      ,
+///  (<see cref="getCursor"/>)       <c>Z_ORDER</c>  <c>TILED</c> (<see cref="hasLines"/>):    
+/// <c>size_t getCapacity(const std::array&lt;std::array&lt;int, 2&gt;, 4&gt;&amp; index)</c>   <c>bool decode(size_t cell, int (&amp;index)[4]) const</c>,
+///     ;      ,     .
+///  <c>Z_ORDER</c>    <c>void forEachCell(Visitor visitor) const</c>,   <c>visitor(size_t cell, const int (&amp;index)[4])</c>
+///     .
+///  <c>TILED</c>     <c>tile</c>        <c>tileLength</c>    .
+///          :  ,     (<see cref="lmatrixn_layout"/>, <see cref="cmatrixn_layout"/>),
+///       (<see cref="lmatrixn_aligned_layout"/>, <see cref="cmatrixn_aligned_layout"/>)    
+/// (<see cref="ilmatrixn_layout"/>, <see cref="icmatrixn_layout"/>).      (<see cref="zmatrix4_layout"/>),    
+///   ,  (<see cref="bmatrix4_tiled_layout"/>),      ,    (<see cref="dmatrix4_layout"/>),
+///          ASDC.Lab4.Benchmark.
+/// </remarks>
+class matrixN
+{
+	/// <summary>
+	///    ,    : <c>int</c>     <see cref="matrixN_no_index"/>  .
+	/// </summary>
+	typedef typename std::conditional<N == 4, int, matrixN_no_index>::type index4;
+
+	std::array<std::array<int, 2>, N> index;
+	std::array<size_t, N + 1> length;
+	matrix4_storage<T> storage;
+	Layout<T> layout;
+
+public:
+	/// <summary>
+	///   .
+	/// </summary>
+	static const int rank = N;
+
+	/// <summary>
+	///      <see cref="matrixN"/>    .
+	/// </summary>
+	/// <remarks>
+	///    ,   <c>new T[]</c>:     .
+	/// </remarks>
+	/// <param name='index'>      .</param>
+	/// <exception cref="std::invalid_argument">      .</exception>
+	matrixN(const std::array<std::array<int, 2>, N>& index);
+
+	/// <summary>
+	///     <see cref="matrixN"/>    ,     .
+	/// </summary>
+	/// <param name='index'>      .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">      .</exception>
+	matrixN(const std::array<std::array<int, 2>, N>& index, ELEMENT_INITIALIZATION initialization);
+
+	/// <summary>
+	///     <see cref="matrixN"/>    ,   ,    .
+	/// </summary>
+	/// <param name='index'>      .</param>
+	/// <param name='array'>,           .</param>
+	/// <param name="length">    <paramref name="array"/></param>
+	/// <exception cref="std::invalid_argument">
+	///       .
+	/// - -
+	///   <paramref name="array"/>  nullptr.
+	/// </exception>
+	matrixN(const std::array<std::array<int, 2>, N>& index, T* array, size_t length);
+
+	template<typename Source>
+	/// <summary>
+	///     <see cref="matrixN"/>    ,      .
+	/// </summary>
+	/// <remarks>
+	///            (<c>Layout&lt;T&gt;::order</c>,   <see cref="forEach"/>)
+	///                <c>new</c>   true,
+	///       false;         (<c>T()</c>).
+	///      , , ,        .
+	///    ,    .
+	/// </remarks>
+	/// <param name='index'>      .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   .</param>
+	/// <exception cref="std::invalid_argument">      .</exception>
+	matrixN(const std::array<std::array<int, 2>, N>& index, Source source);
+
+	/// <summary>
+	///     <see cref="matrixN"/>    ,      .
+	/// </summary>
+	/// <param name='index'>      .</param>
+	/// <param name='array'>,   <c>new T[]</c>;      .</param>
+	/// <param name="length">    <paramref name="array"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///       .
+	/// - -
+	///   <paramref name="array"/>  nullptr.
+	/// - -
+	///   <paramref name="length"/>   ,    (  ).
+	/// - -
+	///      <c>Layout&lt;T&gt;::alignment</c>.
+	/// </exception>
+	matrixN(const std::array<std::array<int, 2>, N>& index, std::unique_ptr<T[]> array, size_t length);
+
+	/// <summary>
+	///     <see cref="matrixN"/>    ,       .
+	/// </summary>
+	/// <param name='index'>      .</param>
+	/// <param name='vector'>,      ;    .</param>
+	/// <exception cref="std::invalid_argument">
+	///       .
+	/// - -
+	///   <paramref name="vector"/>   ,    (  ).
+	/// - -
+	///      <c>Layout&lt;T&gt;::alignment</c>.
+	/// </exception>
+	matrixN(const std::array<std::array<int, 2>, N>& index, std::vector<T>&& vector);
+
+	template<typename... Args>
+	/// <summary>
+	///      <see cref="matrix4"/>    ,   
+	///     <c>std::array</c>:      ,    ,    ,
+	/// , <c>std::unique_ptr&lt;T[]&gt;</c>     <c>std::vector&lt;T&gt;</c>.
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='args'>  .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// - -
+	///     <c>std::array</c>   .
+	/// </exception>
+	matrixN(index4 i1l, index4 i1h, index4 i2l, index4 i2h, index4 i3l, index4 i3h, index4 i4l, index4 i4h, Args&&... args);
+
+	matrixN(const matrixN&) = delete;
+
+	matrixN& operator=(const matrixN&) = delete;
+
+	/// <summary>
+	///    <see cref="matrixN"/>,          .
+	/// </summary>
+	/// <param name='other'>,            .</param>
+	matrixN(matrixN&& other);
+
+	/// <summary>
+	///               .
+	/// </summary>
+	/// <param name='other'>,            .</param>
+	/// <returns>   .</returns>
+	matrixN& operator=(matrixN&& other);
+
+	/// <summary>
+	///   <see cref="matrixN"/>       ,      .
+	/// </summary>
+	/// <param name='index'>      .</param>
+	/// <param name='vector'>  ,      .</param>
+	/// <param name="length">    <paramref name="vector"/>.</param>
+	/// <returns>,      .</returns>
+	/// <exception cref="std::invalid_argument">
+	///       .
+	/// - -
+	///   <paramref name="vector"/>  nullptr.
+	/// - -
+	///   <paramref name="length"/>   ,    (  ).
+	/// - -
+	///      <c>Layout&lt;T&gt;::alignment</c>.
+	/// </exception>
+	static matrixN wrap(const std::array<std::array<int, 2>, N>& index, T* vector, size_t length);
+
+	/// <summary>
+	///    <see cref="matrix4"/>       ,      .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='vector'>  ,      .</param>
+	/// <param name="length">    <paramref name="vector"/>.</param>
+	/// <returns>,      .</returns>
+	/// <exception cref="std::invalid_argument">. <see cref="wrap"/>    <c>std::array</c>.</exception>
+	static matrixN wrap(index4 i1l, index4 i1h, index4 i2l, index4 i2h, index4 i3l, index4 i3h, index4 i4l, index4 i4h, T* vector, size_t length);
+
+	template<typename... Index>
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	T& at(Index... i);
+
+	template<typename... Index>
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <param name='i'> ,    .</param>
+	/// <returns>  ,    .</returns>
+	T& operator()(Index... i);
+
+	template<typename... Args>
+	/// <summary>
+	///       ,      .
+	/// </summary>
+	/// <remarks>
+	///   <c>T(args...)</c>   ,         ;
+	///        ,        .
+	/// </remarks>
+	/// <param name='i'> ,    .</param>
+	/// <param name='args'>  .</param>
+	/// <returns>   .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	T& emplace(const std::array<int, N>& i, Args&&... args);
+
+	template<typename... Args>
+	/// <summary>
+	///         ,      .
+	/// </summary>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <param name='args'>  .</param>
+	/// <returns>   .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	T& emplace(index4 i1, index4 i2, index4 i3, index4 i4, Args&&... args);
+
+	template<typename... Index>
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <remarks>
+	///    <see cref="matrix4_cursor::getOffset"/>      
+	///        ,    <see cref="citizen_table"/>.
+	/// </remarks>
+	/// <param name='i'> ,    .</param>
+	/// <returns>    .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	size_t getOffset(Index... i) const;
+
+	/// <summary>
+	///         <see cref="matrixN"/>.
+	/// </summary>
+	size_t getLength() const;
+
+	/// <summary>
+	///  ,        <see cref="matrixN"/>.
+	/// </summary>
+	/// <param name='dimension'> ,     ,     .</param>
+	/// <returns>32-    ,      .</returns>
+	/// <exception cref="std::out_of_range">  <paramref name="dimension"/>  1   <typeparamref name="N"/>.</exception>
+	int getLength(int dimension) const;
+
+	/// <summary>
+	///    ,         .
+	/// </summary>
+	/// <remarks>     ,     ;      .</remarks>
+	size_t getPitch() const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	int getAddCount() const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	int getMulCount() const;
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	int getIndirectionCount() const;
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">  <paramref name="dimension"/>  1   <typeparamref name="N"/>.</exception>
+	int getLowerBound(int dimension) const;
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">  <paramref name="dimension"/>  1   <typeparamref name="N"/>.</exception>
+	int getUpperBound(int dimension) const;
+
+	template<typename Visitor>
+	/// <summary>
+	///          ,      .
+	/// </summary>
+	/// <param name='visitor'> <c>visitor(T&amp; item, int i1, ..., int iN)</c>,    .</param>
+	void forEach(Visitor visitor);
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>,     .</returns>
+	matrix4_cursor<T, Layout<T>::order> getCursor();
+
+	template<typename Visitor>
+	/// <summary>
+	///          <c>TILED</c>      .
+	/// </summary>
+	/// <remarks>
+	///   <c>Layout&lt;T&gt;::tileLength</c>   ,    (<see cref="simd_kernels"/>)    :
+	///       ,  .       .
+	/// </remarks>
+	/// <param name='visitor'>,   <c>visitor(tile, i1, i2, i3, i4)</c>           .</param>
+	void forEachTile(Visitor visitor);
+
+#ifdef MATRIX4_INSTRUMENTATION
+	/// <summary>
+	///   ,        .
+	/// </summary>
+	/// <returns>    .</returns>
+	address_counter& getCounter() const;
+#endif
+
+private:
+	matrixN(const std::array<std::array<int, 2>, N>& index, T* vector, size_t capacity, void (*release)(T*, size_t, void*));
+
+	template<typename Source>
+	void construct(Source source, ELEMENT_INITIALIZATION initialization);
+
+	template<size_t... K, typename... Index>
+	void checkIndex(std::index_sequence<K...>, Index... i) const;
+
+	template<size_t K>
+	void checkIndex(int i) const;
+
+	template<size_t... K>
+	T& locate(const std::array<int, N>& i, std::index_sequence<K...>);
+
+	template<typename Visitor, size_t... K>
+	static void visit(Visitor& visitor, T& item, const int (&i)[N], std::index_sequence<K...>);
+
+	size_t getCapacity() const;
+
+	static std::array<size_t, N + 1> checkLength(const std::array<std::array<int, 2>, N>& index);
+
+	static const char* getDimensionMessage();
+
+	static const int fast = Layout<T>::order == ROW_MAJOR ? N - 1 : 0;
+};
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout>::matrixN(const std::array<std::array<int, 2>, N>& index) : matrixN(index, DEFAULT_INITIALIZATION)
+{
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout>::matrixN(const std::array<std::array<int, 2>, N>& index, ELEMENT_INITIALIZATION initialization) : matrixN(index, nullptr, 0, matrix4_storage<T>::releaseOwned)
+{
+	construct([](T*) { return false; }, initialization);
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout>::matrixN(const std::array<std::array<int, 2>, N>& index, T * array, size_t length) : matrixN(index, nullptr, 0, matrix4_storage<T>::releaseOwned)
+{
+	if (array == nullptr)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_ARRAY);
+	construct([&array, &length](T* item)
+	{
+		if (length == 0)
+			return false;
+		new (item) T(*array++);
+		length--;
+		return true;
+	}, VALUE_INITIALIZATION);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename Source>
+inline matrixN<T, N, Layout>::matrixN(const std::array<std::array<int, 2>, N>& index, Source source) : matrixN(index, nullptr, 0, matrix4_storage<T>::releaseOwned)
+{
+	construct(source, VALUE_INITIALIZATION);
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout>::matrixN(const std::array<std::array<int, 2>, N>& index, std::unique_ptr<T[]> array, size_t length) : matrixN(index, array.get(), length, matrix4_storage<T>::releaseExternal)
+{
+	//     :      unique_ptr
+	storage.setOwner(matrix4_storage<T>::releaseArray, nullptr);
+	array.release();
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout>::matrixN(const std::array<std::array<int, 2>, N>& index, std::vector<T>&& vector) : matrixN(index, vector.data(), vector.size(), matrix4_storage<T>::releaseExternal)
+{
+	//      
+	storage.setOwner(matrix4_storage<T>::releaseVector, new std::vector<T>(std::move(vector)));
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename... Args>
+inline matrixN<T, N, Layout>::matrixN(index4 i1l, index4 i1h, index4 i2l, index4 i2h, index4 i3l, index4 i3h, index4 i4l, index4 i4h, Args&&... args) :
+	matrixN(std::array<std::array<int, 2>, N>{ { { i1l, i1h }, { i2l, i2h }, { i3l, i3h }, { i4l, i4h } } }, std::forward<Args>(args)...)
+{
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout>::matrixN(const std::array<std::array<int, 2>, N>& index, T * vector, size_t capacity, void (*release)(T*, size_t, void*)) :
+	index(index),
+	length(checkLength(index)),
+	storage(release == matrix4_storage<T>::releaseOwned ? matrix4_storage<T>(getCapacity(), Layout<T>::alignment) : matrix4_storage<T>(vector, release)),
+	layout(index, storage.getVector())
+{
+	static_assert(N >= 1, "      .");
+	static_assert(N == 4 || hasLines(Layout<T>::order), "       .");
+	if (release == matrix4_storage<T>::releaseOwned)
+		return;
+	if (vector == nullptr)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_ARRAY);
+	if (capacity < getCapacity())
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_LENGTH);
+	if ((uintptr_t)vector % Layout<T>::alignment != 0)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_ALIGNMENT);
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout>::matrixN(matrixN && other) : index(other.index), length(other.length), storage(std::move(other.storage)), layout(std::move(other.layout))
+{
+	other.length[0] = 0;
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout> & matrixN<T, N, Layout>::operator=(matrixN && other)
+{
+	if (this != &other)
+	{
+		index = other.index;
+		length = other.length;
+		storage = std::move(other.storage);
+		layout = std::move(other.layout);
+		other.length[0] = 0;
+	}
+	return *this;
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout> matrixN<T, N, Layout>::wrap(const std::array<std::array<int, 2>, N>& index, T * vector, size_t length)
+{
+	return matrixN(index, vector, length, matrix4_storage<T>::releaseExternal);
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrixN<T, N, Layout> matrixN<T, N, Layout>::wrap(index4 i1l, index4 i1h, index4 i2l, index4 i2h, index4 i3l, index4 i3h, index4 i4l, index4 i4h, T * vector, size_t length)
+{
+	return wrap(std::array<std::array<int, 2>, N>{ { { i1l, i1h }, { i2l, i2h }, { i3l, i3h }, { i4l, i4h } } }, vector, length);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename... Index>
+inline T & matrixN<T, N, Layout>::at(Index... i)
+{
+	static_assert(sizeof...(Index) == N, "      .");
+	MATRIX4_COUNT_SCOPE(layout.getCounter());
+	checkIndex(std::make_index_sequence<N>(), (int)i...);
+	return *layout.address(storage.getVector(), (int)i...);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename... Index>
+inline T & matrixN<T, N, Layout>::operator()(Index... i)
+{
+	static_assert(sizeof...(Index) == N, "      .");
+	MATRIX4_COUNT_SCOPE(layout.getCounter());
+	return *layout.address(storage.getVector(), (int)i...);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename... Args>
+inline T & matrixN<T, N, Layout>::emplace(const std::array<int, N>& i, Args&&... args)
+{
+	T* item = &locate(i, std::make_index_sequence<N>());
+	if constexpr (std::is_nothrow_constructible<T, Args...>::value)
+	{
+		item->~T();
+		new (item) T(std::forward<Args>(args)...);
+	}
+	else
+		*item = T(std::forward<Args>(args)...);
+	return *item;
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename... Args>
+inline T & matrixN<T, N, Layout>::emplace(index4 i1, index4 i2, index4 i3, index4 i4, Args&&... args)
+{
+	return emplace(std::array<int, N>{ { i1, i2, i3, i4 } }, std::forward<Args>(args)...);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename... Index>
+inline size_t matrixN<T, N, Layout>::getOffset(Index... i) const
+{
+	static_assert(sizeof...(Index) == N, "      .");
+	checkIndex(std::make_index_sequence<N>(), (int)i...);
+	return (size_t)(layout.address(storage.getVector(), (int)i...) - storage.getVector());
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline size_t matrixN<T, N, Layout>::getLength() const
+{
+	return length[0];
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline int matrixN<T, N, Layout>::getLength(int dimension) const
+{
+	if (dimension < 1 || dimension > N)
+		throw std::out_of_range(getDimensionMessage());
+	return (int)length[dimension];
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline size_t matrixN<T, N, Layout>::getPitch() const
+{
+	if constexpr (!hasLines(Layout<T>::order))
+		return 1;
+	return matrix4_storage<T>::getPitch(length[fast + 1], Layout<T>::alignment);
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline int matrixN<T, N, Layout>::getAddCount() const
+{
+	return layout.getAddCount();
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline int matrixN<T, N, Layout>::getMulCount() const
+{
+	return layout.getMulCount();
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline int matrixN<T, N, Layout>::getIndirectionCount() const
+{
+	return layout.getIndirectionCount();
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline int matrixN<T, N, Layout>::getLowerBound(int dimension) const
+{
+	if (dimension < 1 || dimension > N)
+		throw std::out_of_range(getDimensionMessage());
+	return index[dimension - 1][0];
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline int matrixN<T, N, Layout>::getUpperBound(int dimension) const
+{
+	if (dimension < 1 || dimension > N)
+		throw std::out_of_range(getDimensionMessage());
+	return index[dimension - 1][1];
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename Visitor>
+inline void matrixN<T, N, Layout>::forEach(Visitor visitor)
+{
+	T* item = storage.getVector();
+	int i[N];
+	if constexpr (Layout<T>::order == TILED)
+	{
+		//            
+		const int (&tile)[4] = Layout<T>::tile;
+		forEachTile([&](T* first, int i1, int i2, int i3, int i4)
+		{
+			int n1 = index[0][1] - i1 < tile[0] ? index[0][1] - i1 + 1 : tile[0];
+			int n2 = index[1][1] - i2 < tile[1] ? index[1][1] - i2 + 1 : tile[1];
+			int n3 = index[2][1] - i3 < tile[2] ? index[2][1] - i3 + 1 : tile[2];
+			int n4 = index[3][1] - i4 < tile[3] ? index[3][1] - i4 + 1 : tile[3];
+			for (int w1 = 0; w1 < n1; w1++)
+				for (int w2 = 0; w2 < n2; w2++)
+					for (int w3 = 0; w3 < n3; w3++)
+					{
+						T* line = first + (((size_t)w1 * tile[1] + w2) * tile[2] + w3) * tile[3];
+						for (int w4 = 0; w4 < n4; w4++)
+							visitor(line[w4], i1 + w1, i2 + w2, i3 + w3, i4 + w4);
+					}
+		});
+	}
+	else if constexpr (Layout<T>::order == Z_ORDER)
+	{
+		layout.forEachCell([&](size_t cell, const int (&indices)[N])
+		{
+			visit(visitor, item[cell], indices, std::make_index_sequence<N>());
+		});
+	}
+	else
+	{
+		size_t padding = getPitch() - length[fast + 1];
+		for (int d = 0; d < N; d++)
+			i[d] = index[d][0];
+		for (size_t line = 0, lines = length[0] / length[fast + 1]; line < lines; line++, item += padding)
+		{
+			for (i[fast] = index[fast][0]; i[fast] <= index[fast][1]; i[fast]++)
+				visit(visitor, *item++, i, std::make_index_sequence<N>());
+
+			//       ,      
+			for (int k = 1; k < N; k++)
+			{
+				int d = Layout<T>::order == ROW_MAJOR ? N - 1 - k : k;
+				if (++i[d] <= index[d][1])
+					break;
+				i[d] = index[d][0];
+			}
+		}
+	}
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline matrix4_cursor<T, Layout<T>::order> matrixN<T, N, Layout>::getCursor()
+{
+	static_assert(N == 4, "     .");
+	if constexpr (Layout<T>::order == TILED)
+		return matrix4_cursor<T, TILED>(storage.getVector(), index, Layout<T>::tile);
+	else
+		return matrix4_cursor<T, Layout<T>::order>(storage.getVector(), index, getPitch());
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename Visitor>
+inline void matrixN<T, N, Layout>::forEachTile(Visitor visitor)
+{
+	static_assert(N == 4 && Layout<T>::order == TILED, "        TILED.");
+	//    ,            
+	const int (&tile)[4] = Layout<T>::tile;
+	T* first = storage.getVector();
+	for (size_t o1 = 0; o1 < length[1]; o1 += tile[0])
+		for (size_t o2 = 0; o2 < length[2]; o2 += tile[1])
+			for (size_t o3 = 0; o3 < length[3]; o3 += tile[2])
+				for (size_t o4 = 0; o4 < length[4]; o4 += tile[3], first += Layout<T>::tileLength)
+					visitor(first, index[0][0] + (int)o1, index[1][0] + (int)o2, index[2][0] + (int)o3, index[3][0] + (int)o4);
+}
+
+#ifdef MATRIX4_INSTRUMENTATION
+template<typename T, int N, template<typename> class Layout>
+inline address_counter & matrixN<T, N, Layout>::getCounter() const
+{
+	return layout.getCounter();
+}
+#endif
+
+template<typename T, int N, template<typename> class Layout>
+template<typename Source>
+inline void matrixN<T, N, Layout>::construct(Source source, ELEMENT_INITIALIZATION initialization)
+{
+	if constexpr (!hasLines(Layout<T>::order))
+	{
+		//               ,    
+		int i[4];
+		size_t capacity = getCapacity();
+		for (size_t cell = 0; cell < capacity; cell++)
+		{
+			if (!layout.decode(cell, i))
+				storage.fill(cell + 1, initialization);
+			else
+			{
+				storage.construct(cell + 1, source);
+				if (storage.getCount() == cell)
+					break;
+			}
+		}
+		storage.fill(capacity, initialization);
+		return;
+	}
+
+	//   :         
+	//         
+	size_t width = length[fast + 1];
+	size_t pitch = getPitch();
+	size_t capacity = getCapacity();
+	if (width == pitch)
+		width = pitch = capacity;
+	bool more = true;
+	for (size_t line = 0; line < capacity; line += pitch)
+	{
+		if (more)
+		{
+			storage.construct(line + width, source);
+			more = storage.getCount() == line + width;
+		}
+		storage.fill(line + width, initialization);
+		storage.fill(line + pitch, VALUE_INITIALIZATION);
+	}
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<size_t... K, typename... Index>
+inline void matrixN<T, N, Layout>::checkIndex(std::index_sequence<K...>, Index... i) const
+{
+	(checkIndex<K>(i), ...);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<size_t K>
+inline void matrixN<T, N, Layout>::checkIndex(int i) const
+{
+	//   ,      
+	static const char* const messages[4] = { MESSAGE_OUT_OF_RANGE_I1, MESSAGE_OUT_OF_RANGE_I2, MESSAGE_OUT_OF_RANGE_I3, MESSAGE_OUT_OF_RANGE_I4 };
+	MATRIX4_COUNT(layout.getCounter().record(BOUNDS_CHECK, 2));
+	if (i < index[K][0] || i > index[K][1])
+		throw std::out_of_range(N == 4 ? messages[K % 4] : MESSAGE_OUT_OF_RANGE_INDEX);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<size_t... K>
+inline T & matrixN<T, N, Layout>::locate(const std::array<int, N>& i, std::index_sequence<K...>)
+{
+	return at(i[K]...);
+}
+
+template<typename T, int N, template<typename> class Layout>
+template<typename Visitor, size_t... K>
+inline void matrixN<T, N, Layout>::visit(Visitor& visitor, T & item, const int (&i)[N], std::index_sequence<K...>)
+{
+	visitor(item, i[K]...);
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline size_t matrixN<T, N, Layout>::getCapacity() const
+{
+	if constexpr (!hasLines(Layout<T>::order))
+		return Layout<T>::getCapacity(index);
+	return length[0] / length[fast + 1] * getPitch();
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline std::array<size_t, N + 1> matrixN<T, N, Layout>::checkLength(const std::array<std::array<int, 2>, N>& index)
+{
+	static const char* const messages[4] = { MESSAGE_INVALID_ARGUMENT_I1, MESSAGE_INVALID_ARGUMENT_I2, MESSAGE_INVALID_ARGUMENT_I3, MESSAGE_INVALID_ARGUMENT_I4 };
+	std::array<size_t, N + 1> result;
+	result[0] = 1;
+	for (int d = 0; d < N; d++)
+	{
+		if (index[d][0] > index[d][1])
+			throw std::invalid_argument(N == 4 ? messages[d % 4] : MESSAGE_INVALID_ARGUMENT_INDEX);
+		result[d + 1] = (size_t)((ptrdiff_t)index[d][1] - index[d][0]) + 1;
+		result[0] *= result[d + 1];
+	}
+	return result;
+}
+
+template<typename T, int N, template<typename> class Layout>
+inline const char * matrixN<T, N, Layout>::getDimensionMessage()
+{
+	return N == 4 ? MESSAGE_OUT_OF_RANGE_DIMENSION : MESSAGE_OUT_OF_RANGE_RANK;
+}
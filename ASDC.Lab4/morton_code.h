@@ -0,0 +1,319 @@
+#pragma once
+#include "simd_kernels.h"
+
+/// <summary>
+///       (Z-)      .
+/// </summary>
+/// <remarks>
+///        <c>ceil(log2(length))</c> ;    ,   ,
+///   i4, i3, i2, i1,  ,   ,   .      
+///       ,   2x2x2x2  16  .   <c>2^(  )</c> :
+///       ,     .
+///      <c>pdep</c>  <c>pext</c>,  <see cref="kernel_dispatch::hasBmi2"/>,      ;
+///  <see cref="zmatrix4_layout"/>  BMI2    ,   .
+///     (<see cref="moveNext"/>, <see cref="forEach"/>)      ,     ,
+///   ,       .
+/// </remarks>
+class morton_code
+{
+	/// <summary>
+	///    ,  <see cref="forEach"/>    .
+	/// </summary>
+	static const size_t BLOCK_LENGTH = 64;
+
+	int lower[4];
+	size_t length[4];
+	size_t mask[4];
+	size_t capacity;
+	size_t last;
+	bool bmi2;
+	unsigned char owner[sizeof(size_t) * 8];
+	unsigned char below[sizeof(size_t) * 8][4];
+
+public:
+	/// <summary>
+	///    <see cref="morton_code"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <exception cref="std::bad_alloc">     <c>size_t</c>.</exception>
+	morton_code(const std::array<std::array<int, 2>, 4>& index);
+
+	/// <summary>
+	///       .
+	/// </summary>
+	size_t getCapacity() const;
+
+	/// <summary>
+	///     ,      .
+	/// </summary>
+	/// <param name='dimension'> ,     .</param>
+	size_t getMask(int dimension) const;
+
+	/// <summary>
+	///  true,        BMI2.
+	/// </summary>
+	bool hasBmi2() const;
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  .</returns>
+	size_t encode(int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///     .
+	/// </summary>
+	/// <param name='code'> ,  <see cref="getCapacity"/>.</param>
+	/// <param name='index'>    1-4.</param>
+	/// <returns>true,     ; false,   .</returns>
+	bool decode(size_t code, int (&index)[4]) const;
+
+	/// <summary>
+	///           .
+	/// </summary>
+	/// <param name='code'>  ;   .</param>
+	/// <param name='offset'>        1-4;   .</param>
+	/// <returns>true,     ; false,    ,     .</returns>
+	bool moveNext(size_t& code, size_t (&offset)[4]) const;
+
+	template<typename Visitor>
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <remarks>
+	///            <see cref="BLOCK_LENGTH"/> ,    ,
+	///         <see cref="moveNext"/>.          .
+	/// </remarks>
+	/// <param name='visitor'> <c>visitor(size_t code, const int (&amp;index)[4])</c>,         1-4.</param>
+	void forEach(Visitor visitor) const;
+
+	/// <summary>
+	///          ( <c>pdep</c>).
+	/// </summary>
+	static size_t deposit(size_t value, size_t mask);
+
+	/// <summary>
+	///             ( <c>pext</c>).
+	/// </summary>
+	static size_t extract(size_t value, size_t mask);
+
+private:
+	static int getLowestBit(size_t bit);
+
+	size_t depositBmi2(size_t value, size_t mask) const;
+
+	size_t extractBmi2(size_t value, size_t mask) const;
+};
+
+inline morton_code::morton_code(const std::array<std::array<int, 2>, 4>& index) : bmi2(kernel_dispatch::hasBmi2())
+{
+	int bits[4];
+	int total = 0;
+	for (int d = 0; d < 4; d++)
+	{
+		lower[d] = index[d][0];
+		length[d] = (size_t)((ptrdiff_t)index[d][1] - index[d][0]) + 1;
+		mask[d] = 0;
+		for (bits[d] = 0; ((size_t)1 << bits[d]) < length[d]; bits[d]++)
+			;
+		total += bits[d];
+	}
+	if (total >= (int)(sizeof(size_t) * 8))
+		throw std::bad_alloc();
+	capacity = (size_t)1 << total;
+
+	//      : i4, i3, i2, i1,     ;
+	//     ,   ,       
+	int position = 0;
+	int count[4] = { 0, 0, 0, 0 };
+	for (int level = 0; position < total; level++)
+		for (int d = 3; d >= 0; d--)
+			if (level < bits[d])
+			{
+				for (int k = 0; k < 4; k++)
+					below[position][k] = (unsigned char)count[k];
+				owner[position] = (unsigned char)d;
+				count[d]++;
+				mask[d] |= (size_t)1 << position++;
+			}
+	last = 0;
+	for (int d = 0; d < 4; d++)
+		last |= deposit(length[d] - 1, mask[d]);
+}
+
+inline size_t morton_code::getCapacity() const
+{
+	return capacity;
+}
+
+inline size_t morton_code::getMask(int dimension) const
+{
+	return mask[dimension];
+}
+
+inline bool morton_code::hasBmi2() const
+{
+	return bmi2;
+}
+
+inline size_t morton_code::encode(int i1, int i2, int i3, int i4) const
+{
+	size_t o1 = (size_t)(i1 - lower[0]), o2 = (size_t)(i2 - lower[1]), o3 = (size_t)(i3 - lower[2]), o4 = (size_t)(i4 - lower[3]);
+	if (bmi2)
+		return depositBmi2(o1, mask[0]) | depositBmi2(o2, mask[1]) | depositBmi2(o3, mask[2]) | depositBmi2(o4, mask[3]);
+	return deposit(o1, mask[0]) | deposit(o2, mask[1]) | deposit(o3, mask[2]) | deposit(o4, mask[3]);
+}
+
+inline bool morton_code::decode(size_t code, int (&index)[4]) const
+{
+	size_t offset[4];
+	if (bmi2)
+	{
+		for (int d = 0; d < 4; d++)
+			offset[d] = extractBmi2(code, mask[d]);
+	}
+	else
+	{
+		for (int d = 0; d < 4; d++)
+			offset[d] = extract(code, mask[d]);
+	}
+	for (int d = 0; d < 4; d++)
+		index[d] = lower[d] + (int)offset[d];
+	return offset[0] < length[0] && offset[1] < length[1] && offset[2] < length[2] && offset[3] < length[3];
+}
+
+inline bool morton_code::moveNext(size_t& code, size_t (&offset)[4]) const
+{
+	//        ,        
+	if (code == last)
+		return false;
+	for (;;)
+	{
+		//           :   ,
+		//    ,   ,   ,  
+		size_t carry = ~code & (code + 1);
+		int position = getLowestBit(carry);
+		code++;
+		bool inside = true;
+		for (int d = 0; d < 4; d++)
+		{
+			int bit = below[position][d];
+			offset[d] = (offset[d] & ~(((size_t)1 << bit) - 1)) | ((size_t)(owner[position] == d) << bit);
+			inside &= offset[d] < length[d];
+		}
+		if (inside)
+			return true;
+
+		//     ,      carry      
+		code += carry - 1;
+	}
+}
+
+template<typename Visitor>
+inline void morton_code::forEach(Visitor visitor) const
+{
+	size_t cells = capacity < BLOCK_LENGTH ? capacity : BLOCK_LENGTH;
+	int table[BLOCK_LENGTH][4];
+	for (size_t j = 0; j < cells; j++)
+		for (int d = 0; d < 4; d++)
+			table[j][d] = (int)extract(j, mask[d]);
+
+	//         ;        
+	size_t block = 0, offset[4] = { 0, 0, 0, 0 };
+	int first[4], index[4];
+	size_t rest[4];
+	auto isInside = [&](size_t j)
+	{
+		return (size_t)table[j][0] < rest[0] && (size_t)table[j][1] < rest[1] && (size_t)table[j][2] < rest[2] && (size_t)table[j][3] < rest[3];
+	};
+	for (;;)
+	{
+		for (int d = 0; d < 4; d++)
+		{
+			first[d] = lower[d] + (int)offset[d];
+			rest[d] = length[d] - offset[d];
+		}
+
+		//   ,     ,  ,   ,
+		//       ,      
+		for (size_t j = 0; j < cells; )
+		{
+			size_t size = j == 0 ? cells : j & (~j + 1);
+			if (!isInside(j))
+			{
+				j += size;
+				continue;
+			}
+			while (!isInside(j + size - 1))
+				size >>= 1;
+			for (size_t end = j + size; j < end; j++)
+			{
+				for (int d = 0; d < 4; d++)
+					index[d] = first[d] + table[j][d];
+				visitor(block + j, index);
+			}
+		}
+
+		// moveNext           
+		if (block + cells - 1 >= last)
+			return;
+		block += cells - 1;
+		for (int d = 0; d < 4; d++)
+			offset[d] += (size_t)table[cells - 1][d];
+		moveNext(block, offset);
+	}
+}
+
+inline size_t morton_code::deposit(size_t value, size_t mask)
+{
+	size_t result = 0;
+	for (size_t bit = 1; mask != 0; bit <<= 1, mask &= mask - 1)
+		if ((value & bit) != 0)
+			result |= mask & (~mask + 1);
+	return result;
+}
+
+inline size_t morton_code::extract(size_t value, size_t mask)
+{
+	size_t result = 0;
+	for (size_t bit = 1; mask != 0; bit <<= 1, mask &= mask - 1)
+		if ((value & mask & (~mask + 1)) != 0)
+			result |= bit;
+	return result;
+}
+
+inline int morton_code::getLowestBit(size_t bit)
+{
+	unsigned long index;
+#if defined(_M_X64) || defined(__x86_64__)
+	if (_BitScanForward(&index, (unsigned long)bit))
+		return (int)index;
+	_BitScanForward(&index, (unsigned long)((uint64_t)bit >> 32));
+	return (int)index + 32;
+#else
+	_BitScanForward(&index, (unsigned long)bit);
+	return (int)index;
+#endif
+}
+
+inline size_t morton_code::depositBmi2(size_t value, size_t mask) const
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	return (size_t)_pdep_u64(value, mask);
+#else
+	return (size_t)_pdep_u32(value, mask);
+#endif
+}
+
+inline size_t morton_code::extractBmi2(size_t value, size_t mask) const
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	return (size_t)_pext_u64(value, mask);
+#else
+	return (size_t)_pext_u32(value, mask);
+#endif
+}
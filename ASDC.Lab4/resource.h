@@ -9,4 +9,18 @@
 #define MESSAGE_INVALID_ARGUMENT_I2				"  \"i2l\"       \"i2h\"."
 #define MESSAGE_INVALID_ARGUMENT_I3				"  \"i3l\"       \"i3h\"."
 #define MESSAGE_INVALID_ARGUMENT_I4				"  \"i4l\"       \"i4h\"."
-#define MESSAGE_INVALID_ARGUMENT_ARRAY			"\"array\"   nullptr."
\ No newline at end of file
+#define MESSAGE_INVALID_ARGUMENT_ARRAY			"\"array\"   nullptr."
+#define MESSAGE_LENGTH_ERROR_OFFSET				"     ,  ."
+#define MESSAGE_RUNTIME_ERROR_OPEN				"        ."
+#define MESSAGE_RUNTIME_ERROR_FORMAT			"       ."
+#define MESSAGE_OUT_OF_RANGE_ROW				"  \"row\"        ."
+#define MESSAGE_RUNTIME_ERROR_WRITE				"     ."
+#define MESSAGE_INVALID_ARGUMENT_LENGTH			"  \"length\"     ."
+#define MESSAGE_INVALID_ARGUMENT_ALIGNMENT		"    ,   ."
+#define MESSAGE_INVALID_ARGUMENT_BOUNDS			"    ."
+#define MESSAGE_INVALID_ARGUMENT_STENCIL		"      ."
+#define MESSAGE_INVALID_ARGUMENT_ALIAS			"       ."
+#define MESSAGE_OUT_OF_RANGE_INDEX				"       ."
+#define MESSAGE_OUT_OF_RANGE_RANK				"  \"dimension\"     1    ."
+#define MESSAGE_INVALID_ARGUMENT_INDEX			"       ."
+#define MESSAGE_INVALID_ARGUMENT_TABLE			"        ."
\ No newline at end of file
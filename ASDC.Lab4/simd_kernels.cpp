@@ -0,0 +1,638 @@
+#include "stdafx.h"
+#include "simd_kernels.h"
+
+//   *_vector     :      .
+//       ;     scalar_vector.
+
+template<typename T>
+struct scalar_vector
+{
+	typedef T type;
+	static const size_t width = 1;
+	static type load(const T* p) { return *p; }
+	static void store(T* p, type a) { *p = a; }
+	static type set(T value) { return value; }
+	static type add(type a, type b) { return a + b; }
+	static type subtract(type a, type b) { return a - b; }
+	static type multiply(type a, type b) { return a * b; }
+	static type minimum(type a, type b) { return b < a ? b : a; }
+	static type maximum(type a, type b) { return a < b ? b : a; }
+	static type negate(type a) { return -a; }
+	static type absolute(type a) { return a < 0 ? -a : a; }
+	static type fma(type a, type b, type c) { return a * b + c; }
+	static unsigned within(type a, type low, type high) { return low <= a && a <= high; }
+};
+
+struct sse_float
+{
+	typedef __m128 type;
+	static const size_t width = 4;
+	static type load(const float* p) { return _mm_loadu_ps(p); }
+	static void store(float* p, type a) { _mm_storeu_ps(p, a); }
+	static type set(float value) { return _mm_set1_ps(value); }
+	static type add(type a, type b) { return _mm_add_ps(a, b); }
+	static type subtract(type a, type b) { return _mm_sub_ps(a, b); }
+	static type multiply(type a, type b) { return _mm_mul_ps(a, b); }
+	static type minimum(type a, type b) { return _mm_min_ps(a, b); }
+	static type maximum(type a, type b) { return _mm_max_ps(a, b); }
+	static type negate(type a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+	static type absolute(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	static type fma(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+	static unsigned within(type a, type low, type high) { return (unsigned)_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(a, low), _mm_cmple_ps(a, high))); }
+};
+
+struct sse_double
+{
+	typedef __m128d type;
+	static const size_t width = 2;
+	static type load(const double* p) { return _mm_loadu_pd(p); }
+	static void store(double* p, type a) { _mm_storeu_pd(p, a); }
+	static type set(double value) { return _mm_set1_pd(value); }
+	static type add(type a, type b) { return _mm_add_pd(a, b); }
+	static type subtract(type a, type b) { return _mm_sub_pd(a, b); }
+	static type multiply(type a, type b) { return _mm_mul_pd(a, b); }
+	static type minimum(type a, type b) { return _mm_min_pd(a, b); }
+	static type maximum(type a, type b) { return _mm_max_pd(a, b); }
+	static type negate(type a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+	static type absolute(type a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+	static type fma(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+	static unsigned within(type a, type low, type high) { return (unsigned)_mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(a, low), _mm_cmple_pd(a, high))); }
+};
+
+struct sse_int32
+{
+	typedef __m128i type;
+	static const size_t width = 4;
+	static type load(const int32_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+	static void store(int32_t* p, type a) { _mm_storeu_si128((__m128i*)p, a); }
+	static type set(int32_t value) { return _mm_set1_epi32(value); }
+	static type add(type a, type b) { return _mm_add_epi32(a, b); }
+	static type subtract(type a, type b) { return _mm_sub_epi32(a, b); }
+	static type multiply(type a, type b) { return _mm_mullo_epi32(a, b); }
+	static type minimum(type a, type b) { return _mm_min_epi32(a, b); }
+	static type maximum(type a, type b) { return _mm_max_epi32(a, b); }
+	static type negate(type a) { return _mm_sub_epi32(_mm_setzero_si128(), a); }
+	static type absolute(type a) { return _mm_abs_epi32(a); }
+	static type fma(type a, type b, type c) { return _mm_add_epi32(_mm_mullo_epi32(a, b), c); }
+	static unsigned within(type a, type low, type high) { return ~(unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(_mm_cmpgt_epi32(low, a), _mm_cmpgt_epi32(a, high)))) & 0xF; }
+};
+
+struct sse_int64
+{
+	typedef __m128i type;
+	static const size_t width = 2;
+	static type load(const int64_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+	static void store(int64_t* p, type a) { _mm_storeu_si128((__m128i*)p, a); }
+	static type set(int64_t value) { return _mm_set1_epi64x(value); }
+	static type add(type a, type b) { return _mm_add_epi64(a, b); }
+	static type subtract(type a, type b) { return _mm_sub_epi64(a, b); }
+	//  64      32- 
+	static type multiply(type a, type b)
+	{
+		type cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b), _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+		return _mm_add_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(cross, 32));
+	}
+	static type minimum(type a, type b) { return _mm_blendv_epi8(a, b, _mm_cmpgt_epi64(a, b)); }
+	static type maximum(type a, type b) { return _mm_blendv_epi8(b, a, _mm_cmpgt_epi64(a, b)); }
+	static type negate(type a) { return _mm_sub_epi64(_mm_setzero_si128(), a); }
+	static type absolute(type a)
+	{
+		type sign = _mm_cmpgt_epi64(_mm_setzero_si128(), a);
+		return _mm_sub_epi64(_mm_xor_si128(a, sign), sign);
+	}
+	static type fma(type a, type b, type c) { return _mm_add_epi64(multiply(a, b), c); }
+	static unsigned within(type a, type low, type high) { return ~(unsigned)_mm_movemask_pd(_mm_castsi128_pd(_mm_or_si128(_mm_cmpgt_epi64(low, a), _mm_cmpgt_epi64(a, high)))) & 0x3; }
+};
+
+struct avx2_float
+{
+	typedef __m256 type;
+	static const size_t width = 8;
+	static type load(const float* p) { return _mm256_loadu_ps(p); }
+	static void store(float* p, type a) { _mm256_storeu_ps(p, a); }
+	static type set(float value) { return _mm256_set1_ps(value); }
+	static type add(type a, type b) { return _mm256_add_ps(a, b); }
+	static type subtract(type a, type b) { return _mm256_sub_ps(a, b); }
+	static type multiply(type a, type b) { return _mm256_mul_ps(a, b); }
+	static type minimum(type a, type b) { return _mm256_min_ps(a, b); }
+	static type maximum(type a, type b) { return _mm256_max_ps(a, b); }
+	static type negate(type a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+	static type absolute(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	static type fma(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+	static unsigned within(type a, type low, type high) { return (unsigned)_mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(a, low, _CMP_GE_OQ), _mm256_cmp_ps(a, high, _CMP_LE_OQ))); }
+};
+
+struct avx2_double
+{
+	typedef __m256d type;
+	static const size_t width = 4;
+	static type load(const double* p) { return _mm256_loadu_pd(p); }
+	static void store(double* p, type a) { _mm256_storeu_pd(p, a); }
+	static type set(double value) { return _mm256_set1_pd(value); }
+	static type add(type a, type b) { return _mm256_add_pd(a, b); }
+	static type subtract(type a, type b) { return _mm256_sub_pd(a, b); }
+	static type multiply(type a, type b) { return _mm256_mul_pd(a, b); }
+	static type minimum(type a, type b) { return _mm256_min_pd(a, b); }
+	static type maximum(type a, type b) { return _mm256_max_pd(a, b); }
+	static type negate(type a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+	static type absolute(type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+	static type fma(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+	static unsigned within(type a, type low, type high) { return (unsigned)_mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(a, low, _CMP_GE_OQ), _mm256_cmp_pd(a, high, _CMP_LE_OQ))); }
+};
+
+struct avx2_int32
+{
+	typedef __m256i type;
+	static const size_t width = 8;
+	static type load(const int32_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	static void store(int32_t* p, type a) { _mm256_storeu_si256((__m256i*)p, a); }
+	static type set(int32_t value) { return _mm256_set1_epi32(value); }
+	static type add(type a, type b) { return _mm256_add_epi32(a, b); }
+	static type subtract(type a, type b) { return _mm256_sub_epi32(a, b); }
+	static type multiply(type a, type b) { return _mm256_mullo_epi32(a, b); }
+	static type minimum(type a, type b) { return _mm256_min_epi32(a, b); }
+	static type maximum(type a, type b) { return _mm256_max_epi32(a, b); }
+	static type negate(type a) { return _mm256_sub_epi32(_mm256_setzero_si256(), a); }
+	static type absolute(type a) { return _mm256_abs_epi32(a); }
+	static type fma(type a, type b, type c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+	static unsigned within(type a, type low, type high) { return ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpgt_epi32(low, a), _mm256_cmpgt_epi32(a, high)))) & 0xFF; }
+};
+
+struct avx2_int64
+{
+	typedef __m256i type;
+	static const size_t width = 4;
+	static type load(const int64_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	static void store(int64_t* p, type a) { _mm256_storeu_si256((__m256i*)p, a); }
+	static type set(int64_t value) { return _mm256_set1_epi64x(value); }
+	static type add(type a, type b) { return _mm256_add_epi64(a, b); }
+	static type subtract(type a, type b) { return _mm256_sub_epi64(a, b); }
+	static type multiply(type a, type b)
+	{
+		type cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+		return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+	}
+	static type minimum(type a, type b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+	static type maximum(type a, type b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+	static type negate(type a) { return _mm256_sub_epi64(_mm256_setzero_si256(), a); }
+	static type absolute(type a)
+	{
+		type sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+		return _mm256_sub_epi64(_mm256_xor_si256(a, sign), sign);
+	}
+	static type fma(type a, type b, type c) { return _mm256_add_epi64(multiply(a, b), c); }
+	static unsigned within(type a, type low, type high) { return ~(unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_cmpgt_epi64(low, a), _mm256_cmpgt_epi64(a, high)))) & 0xF; }
+};
+
+struct avx512_float
+{
+	typedef __m512 type;
+	static const size_t width = 16;
+	static type load(const float* p) { return _mm512_loadu_ps(p); }
+	static void store(float* p, type a) { _mm512_storeu_ps(p, a); }
+	static type set(float value) { return _mm512_set1_ps(value); }
+	static type add(type a, type b) { return _mm512_add_ps(a, b); }
+	static type subtract(type a, type b) { return _mm512_sub_ps(a, b); }
+	static type multiply(type a, type b) { return _mm512_mul_ps(a, b); }
+	static type minimum(type a, type b) { return _mm512_min_ps(a, b); }
+	static type maximum(type a, type b) { return _mm512_max_ps(a, b); }
+	//    float  AVX-512  AVX512DQ,     
+	static type negate(type a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(INT32_MIN))); }
+	static type absolute(type a) { return _mm512_abs_ps(a); }
+	static type fma(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+	static unsigned within(type a, type low, type high) { return _mm512_cmp_ps_mask(a, low, _CMP_GE_OQ) & _mm512_cmp_ps_mask(a, high, _CMP_LE_OQ); }
+};
+
+struct avx512_double
+{
+	typedef __m512d type;
+	static const size_t width = 8;
+	static type load(const double* p) { return _mm512_loadu_pd(p); }
+	static void store(double* p, type a) { _mm512_storeu_pd(p, a); }
+	static type set(double value) { return _mm512_set1_pd(value); }
+	static type add(type a, type b) { return _mm512_add_pd(a, b); }
+	static type subtract(type a, type b) { return _mm512_sub_pd(a, b); }
+	static type multiply(type a, type b) { return _mm512_mul_pd(a, b); }
+	static type minimum(type a, type b) { return _mm512_min_pd(a, b); }
+	static type maximum(type a, type b) { return _mm512_max_pd(a, b); }
+	static type negate(type a) { return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(INT64_MIN))); }
+	static type absolute(type a) { return _mm512_abs_pd(a); }
+	static type fma(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+	static unsigned within(type a, type low, type high) { return _mm512_cmp_pd_mask(a, low, _CMP_GE_OQ) & _mm512_cmp_pd_mask(a, high, _CMP_LE_OQ); }
+};
+
+struct avx512_int32
+{
+	typedef __m512i type;
+	static const size_t width = 16;
+	static type load(const int32_t* p) { return _mm512_loadu_si512(p); }
+	static void store(int32_t* p, type a) { _mm512_storeu_si512(p, a); }
+	static type set(int32_t value) { return _mm512_set1_epi32(value); }
+	static type add(type a, type b) { return _mm512_add_epi32(a, b); }
+	static type subtract(type a, type b) { return _mm512_sub_epi32(a, b); }
+	static type multiply(type a, type b) { return _mm512_mullo_epi32(a, b); }
+	static type minimum(type a, type b) { return _mm512_min_epi32(a, b); }
+	static type maximum(type a, type b) { return _mm512_max_epi32(a, b); }
+	static type negate(type a) { return _mm512_sub_epi32(_mm512_setzero_si512(), a); }
+	static type absolute(type a) { return _mm512_abs_epi32(a); }
+	static type fma(type a, type b, type c) { return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c); }
+	static unsigned within(type a, type low, type high) { return _mm512_cmpge_epi32_mask(a, low) & _mm512_cmple_epi32_mask(a, high); }
+};
+
+struct avx512_int64
+{
+	typedef __m512i type;
+	static const size_t width = 8;
+	static type load(const int64_t* p) { return _mm512_loadu_si512(p); }
+	static void store(int64_t* p, type a) { _mm512_storeu_si512(p, a); }
+	static type set(int64_t value) { return _mm512_set1_epi64(value); }
+	static type add(type a, type b) { return _mm512_add_epi64(a, b); }
+	static type subtract(type a, type b) { return _mm512_sub_epi64(a, b); }
+	// _mm512_mullo_epi64  AVX512DQ
+	static type multiply(type a, type b)
+	{
+		type cross = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), b), _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)));
+		return _mm512_add_epi64(_mm512_mul_epu32(a, b), _mm512_slli_epi64(cross, 32));
+	}
+	static type minimum(type a, type b) { return _mm512_min_epi64(a, b); }
+	static type maximum(type a, type b) { return _mm512_max_epi64(a, b); }
+	static type negate(type a) { return _mm512_sub_epi64(_mm512_setzero_si512(), a); }
+	static type absolute(type a) { return _mm512_abs_epi64(a); }
+	static type fma(type a, type b, type c) { return _mm512_add_epi64(multiply(a, b), c); }
+	static unsigned within(type a, type low, type high) { return _mm512_cmpge_epi64_mask(a, low) & _mm512_cmple_epi64_mask(a, high); }
+};
+
+template<typename T>
+struct isa_vectors;
+
+template<>
+struct isa_vectors<float>
+{
+	typedef sse_float sse42;
+	typedef avx2_float avx2;
+	typedef avx512_float avx512;
+};
+
+template<>
+struct isa_vectors<double>
+{
+	typedef sse_double sse42;
+	typedef avx2_double avx2;
+	typedef avx512_double avx512;
+};
+
+template<>
+struct isa_vectors<int32_t>
+{
+	typedef sse_int32 sse42;
+	typedef avx2_int32 avx2;
+	typedef avx512_int32 avx512;
+};
+
+template<>
+struct isa_vectors<int64_t>
+{
+	typedef sse_int64 sse42;
+	typedef avx2_int64 avx2;
+	typedef avx512_int64 avx512;
+};
+
+template<typename V>
+struct add_operation
+{
+	static typename V::type apply(typename V::type a, typename V::type b) { return V::add(a, b); }
+};
+
+template<typename V>
+struct subtract_operation
+{
+	static typename V::type apply(typename V::type a, typename V::type b) { return V::subtract(a, b); }
+};
+
+template<typename V>
+struct multiply_operation
+{
+	static typename V::type apply(typename V::type a, typename V::type b) { return V::multiply(a, b); }
+};
+
+template<typename V>
+struct minimum_operation
+{
+	static typename V::type apply(typename V::type a, typename V::type b) { return V::minimum(a, b); }
+};
+
+template<typename V>
+struct maximum_operation
+{
+	static typename V::type apply(typename V::type a, typename V::type b) { return V::maximum(a, b); }
+};
+
+template<typename V>
+struct negate_operation
+{
+	static typename V::type apply(typename V::type a) { return V::negate(a); }
+};
+
+template<typename V>
+struct absolute_operation
+{
+	static typename V::type apply(typename V::type a) { return V::absolute(a); }
+};
+
+template<typename V>
+struct square_operation
+{
+	static typename V::type apply(typename V::type a) { return V::multiply(a, a); }
+};
+
+template<template<typename> class Operation, typename V, typename T>
+static void transformBinary(const T* a, const T* b, T* result, size_t length)
+{
+	typedef scalar_vector<T> S;
+	size_t i = 0;
+	for (; i + V::width <= length; i += V::width)
+		V::store(result + i, Operation<V>::apply(V::load(a + i), V::load(b + i)));
+	for (; i < length; i++)
+		result[i] = Operation<S>::apply(a[i], b[i]);
+}
+
+template<template<typename> class Operation, typename V, typename T>
+static void transformUnary(const T* a, T* result, size_t length)
+{
+	typedef scalar_vector<T> S;
+	size_t i = 0;
+	for (; i + V::width <= length; i += V::width)
+		V::store(result + i, Operation<V>::apply(V::load(a + i)));
+	for (; i < length; i++)
+		result[i] = Operation<S>::apply(a[i]);
+}
+
+template<template<typename> class Operation, typename V, typename T>
+static T reduce(const T* a, size_t length, T initial)
+{
+	//      
+	typedef scalar_vector<T> S;
+	typename V::type accumulator[4] = { V::set(initial), V::set(initial), V::set(initial), V::set(initial) };
+	size_t i = 0;
+	for (; i + 4 * V::width <= length; i += 4 * V::width)
+		for (int k = 0; k < 4; k++)
+			accumulator[k] = Operation<V>::apply(accumulator[k], V::load(a + i + k * V::width));
+	for (; i + V::width <= length; i += V::width)
+		accumulator[0] = Operation<V>::apply(accumulator[0], V::load(a + i));
+	accumulator[0] = Operation<V>::apply(Operation<V>::apply(accumulator[0], accumulator[1]), Operation<V>::apply(accumulator[2], accumulator[3]));
+
+	T lanes[V::width];
+	V::store(lanes, accumulator[0]);
+	T result = initial;
+	for (size_t k = 0; k < V::width; k++)
+		result = Operation<S>::apply(result, lanes[k]);
+	for (; i < length; i++)
+		result = Operation<S>::apply(result, a[i]);
+	return result;
+}
+
+template<typename V, typename T>
+static void scaleKernel(T alpha, const T* a, T* result, size_t length)
+{
+	typename V::type factor = V::set(alpha);
+	size_t i = 0;
+	for (; i + V::width <= length; i += V::width)
+		V::store(result + i, V::multiply(factor, V::load(a + i)));
+	for (; i < length; i++)
+		result[i] = alpha * a[i];
+}
+
+template<typename V, typename T>
+static void axpyKernel(T alpha, const T* x, T* y, size_t length)
+{
+	typename V::type factor = V::set(alpha);
+	size_t i = 0;
+	for (; i + V::width <= length; i += V::width)
+		V::store(y + i, V::fma(factor, V::load(x + i), V::load(y + i)));
+	for (; i < length; i++)
+		y[i] = alpha * x[i] + y[i];
+}
+
+template<typename V, typename T>
+static T dotKernel(const T* a, const T* b, size_t length)
+{
+	typedef scalar_vector<T> S;
+	typename V::type accumulator[4] = { V::set(0), V::set(0), V::set(0), V::set(0) };
+	size_t i = 0;
+	for (; i + 4 * V::width <= length; i += 4 * V::width)
+		for (int k = 0; k < 4; k++)
+			accumulator[k] = V::fma(V::load(a + i + k * V::width), V::load(b + i + k * V::width), accumulator[k]);
+	for (; i + V::width <= length; i += V::width)
+		accumulator[0] = V::fma(V::load(a + i), V::load(b + i), accumulator[0]);
+	accumulator[0] = V::add(V::add(accumulator[0], accumulator[1]), V::add(accumulator[2], accumulator[3]));
+
+	T lanes[V::width];
+	V::store(lanes, accumulator[0]);
+	T result = 0;
+	for (size_t k = 0; k < V::width; k++)
+		result = S::add(result, lanes[k]);
+	for (; i < length; i++)
+		result = S::fma(a[i], b[i], result);
+	return result;
+}
+
+template<typename V, typename T>
+static void betweenKernel(T low, T high, const T* a, uint64_t* mask, size_t length)
+{
+	//        :    64
+	typedef scalar_vector<T> S;
+	typename V::type lower = V::set(low), upper = V::set(high);
+	size_t i = 0;
+	for (; i + 64 <= length; i += 64)
+	{
+		uint64_t bits = 0;
+		for (size_t k = 0; k < 64; k += V::width)
+			bits |= (uint64_t)V::within(V::load(a + i + k), lower, upper) << k;
+		mask[i / 64] &= bits;
+	}
+	if (i < length)
+	{
+		uint64_t bits = 0;
+		for (size_t k = 0; i + k < length; k++)
+			bits |= (uint64_t)S::within(a[i + k], low, high) << k;
+		mask[i / 64] &= bits;
+	}
+}
+
+template<typename T, typename Kernel>
+static auto dispatch(Kernel kernel)
+{
+	switch (kernel_dispatch::getIsa())
+	{
+	case ISA_AVX512:
+		return kernel(typename isa_vectors<T>::avx512());
+	case ISA_AVX2:
+		return kernel(typename isa_vectors<T>::avx2());
+	case ISA_SSE42:
+		return kernel(typename isa_vectors<T>::sse42());
+	default:
+		return kernel(scalar_vector<T>());
+	}
+}
+
+KERNEL_ISA kernel_dispatch::getSupportedIsa()
+{
+	static KERNEL_ISA supported = detect();
+	return supported;
+}
+
+KERNEL_ISA kernel_dispatch::getIsa()
+{
+	return current();
+}
+
+void kernel_dispatch::setIsa(KERNEL_ISA isa)
+{
+	current() = isa < getSupportedIsa() ? isa : getSupportedIsa();
+}
+
+bool kernel_dispatch::hasBmi2()
+{
+	static bool supported = detectBmi2();
+	return supported && getIsa() != ISA_SCALAR;
+}
+
+KERNEL_ISA & kernel_dispatch::current()
+{
+	static KERNEL_ISA isa = getSupportedIsa();
+	return isa;
+}
+
+KERNEL_ISA kernel_dispatch::detect()
+{
+	int info[4];
+	__cpuid(info, 0);
+	int leaves = info[0];
+	__cpuid(info, 1);
+	bool sse42 = (info[2] & (1 << 20)) != 0;
+	bool fma = (info[2] & (1 << 12)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!sse42)
+		return ISA_SCALAR;
+	if (!osxsave || !avx || leaves < 7)
+		return ISA_SSE42;
+
+	//  YMM ( 1-2)  ZMM   ( 5-7)    
+	unsigned long long xcr0 = _xgetbv(0);
+	if ((xcr0 & 0x06) != 0x06)
+		return ISA_SSE42;
+	__cpuidex(info, 7, 0);
+	bool avx2 = (info[1] & (1 << 5)) != 0;
+	bool avx512 = (info[1] & (1 << 16)) != 0;
+	if (avx512 && (xcr0 & 0xE6) == 0xE6)
+		return ISA_AVX512;
+	if (avx2 && fma)
+		return ISA_AVX2;
+	return ISA_SSE42;
+}
+
+bool kernel_dispatch::detectBmi2()
+{
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 8)) != 0;
+}
+
+template<typename T>
+void simd_kernels<T>::binary(BINARY_OPERATION operation, const T * a, const T * b, T * result, size_t length)
+{
+	dispatch<T>([&](auto vector)
+	{
+		typedef decltype(vector) V;
+		switch (operation)
+		{
+		case BINARY_ADD:
+			transformBinary<add_operation, V>(a, b, result, length);
+			break;
+		case BINARY_SUBTRACT:
+			transformBinary<subtract_operation, V>(a, b, result, length);
+			break;
+		case BINARY_MULTIPLY:
+			transformBinary<multiply_operation, V>(a, b, result, length);
+			break;
+		case BINARY_MINIMUM:
+			transformBinary<minimum_operation, V>(a, b, result, length);
+			break;
+		case BINARY_MAXIMUM:
+			transformBinary<maximum_operation, V>(a, b, result, length);
+			break;
+		}
+	});
+}
+
+template<typename T>
+void simd_kernels<T>::unary(UNARY_OPERATION operation, const T * a, T * result, size_t length)
+{
+	dispatch<T>([&](auto vector)
+	{
+		typedef decltype(vector) V;
+		switch (operation)
+		{
+		case UNARY_NEGATE:
+			transformUnary<negate_operation, V>(a, result, length);
+			break;
+		case UNARY_ABSOLUTE:
+			transformUnary<absolute_operation, V>(a, result, length);
+			break;
+		case UNARY_SQUARE:
+			transformUnary<square_operation, V>(a, result, length);
+			break;
+		}
+	});
+}
+
+template<typename T>
+void simd_kernels<T>::scale(T alpha, const T * a, T * result, size_t length)
+{
+	dispatch<T>([&](auto vector) { scaleKernel<decltype(vector)>(alpha, a, result, length); });
+}
+
+template<typename T>
+void simd_kernels<T>::axpy(T alpha, const T * x, T * y, size_t length)
+{
+	dispatch<T>([&](auto vector) { axpyKernel<decltype(vector)>(alpha, x, y, length); });
+}
+
+template<typename T>
+T simd_kernels<T>::sum(const T * a, size_t length)
+{
+	return dispatch<T>([&](auto vector) { return reduce<add_operation, decltype(vector)>(a, length, (T)0); });
+}
+
+template<typename T>
+T simd_kernels<T>::minimum(const T * a, size_t length)
+{
+	return dispatch<T>([&](auto vector) { return reduce<minimum_operation, decltype(vector)>(a, length, a[0]); });
+}
+
+template<typename T>
+T simd_kernels<T>::maximum(const T * a, size_t length)
+{
+	return dispatch<T>([&](auto vector) { return reduce<maximum_operation, decltype(vector)>(a, length, a[0]); });
+}
+
+template<typename T>
+T simd_kernels<T>::dot(const T * a, const T * b, size_t length)
+{
+	return dispatch<T>([&](auto vector) { return dotKernel<decltype(vector)>(a, b, length); });
+}
+
+template<typename T>
+void simd_kernels<T>::between(T low, T high, const T * a, uint64_t * mask, size_t length)
+{
+	dispatch<T>([&](auto vector) { betweenKernel<decltype(vector)>(low, high, a, mask, length); });
+}
+
+template class simd_kernels<float>;
+template class simd_kernels<double>;
+template class simd_kernels<int32_t>;
+template class simd_kernels<int64_t>;
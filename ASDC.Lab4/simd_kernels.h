@@ -0,0 +1,155 @@
+#pragma once
+
+/// <summary>
+///    ,    <see cref="simd_kernels"/>.
+/// </summary>
+enum KERNEL_ISA : int
+{
+	ISA_SCALAR, ISA_SSE42, ISA_AVX2, ISA_AVX512
+};
+
+/// <summary>
+///      .
+/// </summary>
+enum BINARY_OPERATION : int
+{
+	BINARY_ADD, BINARY_SUBTRACT, BINARY_MULTIPLY, BINARY_MINIMUM, BINARY_MAXIMUM
+};
+
+/// <summary>
+///      .
+/// </summary>
+enum UNARY_OPERATION : int
+{
+	UNARY_NEGATE, UNARY_ABSOLUTE, UNARY_SQUARE
+};
+
+/// <summary>
+///    ,  ,   ,   .
+/// </summary>
+/// <remarks>
+///         <c>cpuid</c>  <c>xgetbv</c>:    ,     .
+/// <c>ISA_AVX2</c>   FMA, <c>ISA_AVX512</c>   AVX-512F.
+/// </remarks>
+class kernel_dispatch
+{
+public:
+	/// <summary>
+	///     ,     .
+	/// </summary>
+	static KERNEL_ISA getSupportedIsa();
+
+	/// <summary>
+	///    ,   .
+	/// </summary>
+	static KERNEL_ISA getIsa();
+
+	/// <summary>
+	///    ,    ;     .
+	/// </summary>
+	/// <param name='isa'>  .</param>
+	static void setIsa(KERNEL_ISA isa);
+
+	/// <summary>
+	///  true,     <c>pdep</c>  <c>pext</c> (BMI2)    <c>ISA_SCALAR</c>.
+	/// </summary>
+	/// <remarks>  <see cref="zmatrix4_layout"/>;  <c>ISA_SCALAR</c>    .</remarks>
+	static bool hasBmi2();
+
+private:
+	static KERNEL_ISA& current();
+
+	static KERNEL_ISA detect();
+
+	static bool detectBmi2();
+};
+
+template<typename T>
+/// <summary>
+///         <typeparamref name="T"/> (<c>float</c>, <c>double</c>, <c>int32_t</c>  <c>int64_t</c>).
+/// </summary>
+/// <remarks>
+///      <see cref="kernel_dispatch::getIsa"/>  ;  ,    ,  .
+///       .       2^N,    ;
+///           .
+/// </remarks>
+class simd_kernels
+{
+public:
+	/// <summary>
+	///  <c>result[i] = a[i] operation b[i]</c>.
+	/// </summary>
+	/// <param name='operation'> .</param>
+	/// <param name='a'> .</param>
+	/// <param name='b'> .</param>
+	/// <param name='result'>.</param>
+	/// <param name='length'> .</param>
+	static void binary(BINARY_OPERATION operation, const T* a, const T* b, T* result, size_t length);
+
+	/// <summary>
+	///  <c>result[i] = operation(a[i])</c>.
+	/// </summary>
+	/// <param name='operation'> .</param>
+	/// <param name='a'>.</param>
+	/// <param name='result'>.</param>
+	/// <param name='length'> .</param>
+	static void unary(UNARY_OPERATION operation, const T* a, T* result, size_t length);
+
+	/// <summary>
+	///  <c>result[i] = alpha * a[i]</c>.
+	/// </summary>
+	/// <param name='alpha'>.</param>
+	/// <param name='a'>.</param>
+	/// <param name='result'>.</param>
+	/// <param name='length'> .</param>
+	static void scale(T alpha, const T* a, T* result, size_t length);
+
+	/// <summary>
+	///  <c>y[i] = alpha * x[i] + y[i]</c>;       AVX2  AVX-512  FMA.
+	/// </summary>
+	/// <param name='alpha'>.</param>
+	/// <param name='x'>.</param>
+	/// <param name='y'>  .</param>
+	/// <param name='length'> .</param>
+	static void axpy(T alpha, const T* x, T* y, size_t length);
+
+	/// <summary>
+	///   .
+	/// </summary>
+	/// <param name='a'>.</param>
+	/// <param name='length'> ;   .</param>
+	static T sum(const T* a, size_t length);
+
+	/// <summary>
+	///   .
+	/// </summary>
+	/// <param name='a'>.</param>
+	/// <param name='length'> ;   .</param>
+	static T minimum(const T* a, size_t length);
+
+	/// <summary>
+	///   .
+	/// </summary>
+	/// <param name='a'>.</param>
+	/// <param name='length'> ;   .</param>
+	static T maximum(const T* a, size_t length);
+
+	/// <summary>
+	///    <c>a[0] * b[0] + ... + a[length - 1] * b[length - 1]</c>.
+	/// </summary>
+	/// <param name='a'> .</param>
+	/// <param name='b'> .</param>
+	/// <param name='length'> .</param>
+	static T dot(const T* a, const T* b, size_t length);
+
+	/// <summary>
+	///      ,     <c>[low, high]</c>;   <c>a[i]</c>   <c>i % 64</c>  <c>mask[i / 64]</c>.
+	/// </summary>
+	/// <remarks>       .  NaN    .</remarks>
+	/// <param name='low'>  .</param>
+	/// <param name='high'>  .</param>
+	/// <param name='a'>.</param>
+	/// <param name='mask'>   <c>(length + 63) / 64</c> ,       .</param>
+	/// <param name='length'> .</param>
+	static void between(T low, T high, const T* a, uint64_t* mask, size_t length);
+};
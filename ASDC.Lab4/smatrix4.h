@@ -0,0 +1,478 @@
+#pragma once
+#include "matrix4.h"
+
+template<typename T>
+/// <summary>
+///      ,      .
+/// </summary>
+/// <remarks>
+///         :   <c>ceil(log2(length))</c> ,   ,
+///        <see cref="lmatrix4"/>.       ,
+///  -       (  )      
+///      .     ,    .
+///        (<see cref="forEach"/>)         .
+/// <see cref="at"/>       ;       ,   <c>std::vector</c>.
+/// </remarks>
+class smatrix4 : public matrix4<T>
+{
+	int index[4][2];
+	size_t length[5];
+	int shift[4];
+	size_t mask[4];
+	std::vector<size_t> keys;
+	std::vector<T> values;
+	std::vector<size_t> slots;
+	int slotBits;
+	bool sorted;
+
+public:
+	/// <summary>
+	///        <see cref="smatrix4"/>    .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	/// <exception cref="std::length_error">      <c>size_t</c>.</exception>
+	smatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
+
+	/// <summary>
+	///     ,      ,    .
+	/// </summary>
+	/// <param name='i1'>  ,     .</param>
+	/// <param name='i2'>  ,     .</param>
+	/// <param name='i3'>  ,     .</param>
+	/// <param name='i4'>  ,     .</param>
+	/// <returns>  ,     .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	T& at(int i1, int i2, int i3, int i4);
+
+	/// <summary>
+	///      ,   .
+	/// </summary>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>    nullptr,    .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	T* find(int i1, int i2, int i3, int i4);
+
+	template<typename... Args>
+	/// <summary>
+	///      ,    ,   .
+	/// </summary>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <param name='args'>  <typeparamref name="T"/>.</param>
+	/// <returns>  ,     .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	T& emplace(int i1, int i2, int i3, int i4, Args&&... args);
+
+	/// <summary>
+	///        ,   .
+	/// </summary>
+	/// <remarks>
+	///      ,  -   .     ,
+	///    <see cref="forEach"/>,      .
+	/// </remarks>
+	/// <param name='indices'> ,    .</param>
+	/// <param name='array'>  .</param>
+	/// <param name='length'>    <paramref name="array"/>.</param>
+	/// <exception cref="std::invalid_argument">  <paramref name="indices"/>  <paramref name="array"/>  nullptr   <paramref name="length"/>.</exception>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	void insert(const int (*indices)[4], const T* array, size_t length);
+
+	/// <summary>
+	///       ,      -.
+	/// </summary>
+	/// <param name='count'>  .</param>
+	void reserve(size_t count);
+
+	/// <summary>
+	///    .
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	///    .
+	/// </summary>
+	size_t getCount() const;
+
+	template<typename Visitor>
+	/// <summary>
+	///       <see cref="lmatrix4"/>:     .
+	/// </summary>
+	/// <param name='visitor'> <c>visitor(T&amp; item, int i1, int i2, int i3, int i4)</c>,     .</param>
+	void forEach(Visitor visitor);
+
+	/// <summary>
+	///         <see cref="smatrix4"/>,  .
+	/// </summary>
+	size_t getLength();
+
+	/// <summary>
+	///  ,        <see cref="smatrix4"/>.
+	/// </summary>
+	/// <param name='dimension'>  <see cref="smatrix4"/>,     ,     .</param>
+	/// <returns>32-    ,      .</returns>
+	/// <exception cref="std::out_of_range">
+	///   <paramref name="dimension"/>  .
+	/// -  -
+	///   <paramref name="dimension"/>  .
+	/// </exception>
+	int getLength(int dimension);
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <remarks>
+	///  -  :             .
+	/// </remarks>
+	/// <returns>32-    ,        .</returns>
+	int getAddCount();
+
+	/// <summary>
+	///  ,             -.
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	int getMulCount();
+
+	/// <summary>
+	///  ,               -.
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	int getIndirectionCount();
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">
+	///   <paramref name="dimension"/>  .
+	/// -  -
+	///   <paramref name="dimension"/>  .
+	/// </exception>
+	int getLowerBound(int dimension);
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">
+	///   <paramref name="dimension"/>  .
+	/// -  -
+	///   <paramref name="dimension"/>  .
+	/// </exception>
+	int getUpperBound(int dimension);
+
+private:
+	size_t getKey(int i1, int i2, int i3, int i4) const;
+
+	size_t getSlot(size_t key) const;
+
+	/// <summary>
+	///          <c>keys.size()</c>,    .
+	/// </summary>
+	size_t locate(size_t key) const;
+
+	/// <summary>
+	///     - ,     ,    .
+	/// </summary>
+	template<typename... Args>
+	size_t append(size_t key, Args&&... args);
+
+	/// <summary>
+	///   -  <c>2^bits</c>    .
+	/// </summary>
+	void rehash(int bits);
+
+	/// <summary>
+	///        .
+	/// </summary>
+	void sort();
+
+	static size_t checkLength(int lower, int upper, const char* message);
+};
+
+template<typename T>
+inline smatrix4<T>::smatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) :
+	index{ { i1l, i1h }, { i2l, i2h }, { i3l, i3h }, { i4l, i4h } },
+	length{ 0, checkLength(i1l, i1h, MESSAGE_INVALID_ARGUMENT_I1), checkLength(i2l, i2h, MESSAGE_INVALID_ARGUMENT_I2), checkLength(i3l, i3h, MESSAGE_INVALID_ARGUMENT_I3), checkLength(i4l, i4h, MESSAGE_INVALID_ARGUMENT_I4) },
+	slotBits(0), sorted(true)
+{
+	//      ,   
+	int total = 0;
+	for (int d = 3; d >= 0; d--)
+	{
+		int bits = 0;
+		while (((size_t)1 << bits) < length[d + 1])
+			bits++;
+		shift[d] = total;
+		mask[d] = ((size_t)1 << bits) - 1;
+		total += bits;
+	}
+	if (total >= (int)(sizeof(size_t) * 8))
+		throw std::length_error(MESSAGE_LENGTH_ERROR_OFFSET);
+	length[0] = length[1] * length[2] * length[3] * length[4];
+	slots.assign(1, 0);
+}
+
+template<typename T>
+inline T & smatrix4<T>::at(int i1, int i2, int i3, int i4)
+{
+	size_t key = getKey(i1, i2, i3, i4);
+	size_t position = locate(key);
+	if (position == keys.size())
+		position = append(key);
+	return values[position];
+}
+
+template<typename T>
+inline T * smatrix4<T>::find(int i1, int i2, int i3, int i4)
+{
+	size_t position = locate(getKey(i1, i2, i3, i4));
+	return position == keys.size() ? nullptr : &values[position];
+}
+
+template<typename T>
+template<typename... Args>
+inline T & smatrix4<T>::emplace(int i1, int i2, int i3, int i4, Args&&... args)
+{
+	size_t key = getKey(i1, i2, i3, i4);
+	size_t position = locate(key);
+	if (position == keys.size())
+		return values[append(key, std::forward<Args>(args)...)];
+	values[position] = T(std::forward<Args>(args)...);
+	return values[position];
+}
+
+template<typename T>
+inline void smatrix4<T>::insert(const int (*indices)[4], const T * array, size_t length)
+{
+	if (length == 0)
+		return;
+	if (indices == nullptr || array == nullptr)
+		throw std::invalid_argument(MESSAGE_INVALID_ARGUMENT_ARRAY);
+	std::vector<size_t> inserted(length);
+	for (size_t k = 0; k < length; k++)
+		inserted[k] = getKey(indices[k][0], indices[k][1], indices[k][2], indices[k][3]);
+	reserve(keys.size() + length);
+	for (size_t k = 0; k < length; k++)
+	{
+		size_t position = locate(inserted[k]);
+		if (position == keys.size())
+			append(inserted[k], array[k]);
+		else
+			values[position] = array[k];
+	}
+}
+
+template<typename T>
+inline void smatrix4<T>::reserve(size_t count)
+{
+	int bits = slotBits;
+	while (((size_t)1 << bits) < count * 2)
+		bits++;
+	keys.reserve(count);
+	values.reserve(count);
+	if (bits != slotBits)
+		rehash(bits);
+}
+
+template<typename T>
+inline void smatrix4<T>::clear()
+{
+	keys.clear();
+	values.clear();
+	slots.assign(slots.size(), 0);
+	sorted = true;
+}
+
+template<typename T>
+inline size_t smatrix4<T>::getCount() const
+{
+	return keys.size();
+}
+
+template<typename T>
+template<typename Visitor>
+inline void smatrix4<T>::forEach(Visitor visitor)
+{
+	if (!sorted)
+		sort();
+	for (size_t k = 0; k < keys.size(); k++)
+	{
+		size_t key = keys[k];
+		visitor(values[k], index[0][0] + (int)((key >> shift[0]) & mask[0]), index[1][0] + (int)((key >> shift[1]) & mask[1]),
+			index[2][0] + (int)((key >> shift[2]) & mask[2]), index[3][0] + (int)(key & mask[3]));
+	}
+}
+
+template<typename T>
+inline size_t smatrix4<T>::getLength()
+{
+	return length[0];
+}
+
+template<typename T>
+inline int smatrix4<T>::getLength(int dimension)
+{
+	if (dimension < 1 || dimension > 4)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_DIMENSION);
+	return (int)length[dimension];
+}
+
+template<typename T>
+inline int smatrix4<T>::getAddCount()
+{
+	return 4;
+}
+
+template<typename T>
+inline int smatrix4<T>::getMulCount()
+{
+	return 1;
+}
+
+template<typename T>
+inline int smatrix4<T>::getIndirectionCount()
+{
+	return 0;
+}
+
+template<typename T>
+inline int smatrix4<T>::getLowerBound(int dimension)
+{
+	if (dimension < 1 || dimension > 4)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_DIMENSION);
+	return index[dimension - 1][0];
+}
+
+template<typename T>
+inline int smatrix4<T>::getUpperBound(int dimension)
+{
+	if (dimension < 1 || dimension > 4)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_DIMENSION);
+	return index[dimension - 1][1];
+}
+
+template<typename T>
+inline size_t smatrix4<T>::getKey(int i1, int i2, int i3, int i4) const
+{
+	if (i1 < index[0][0] || i1 > index[0][1])
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I1);
+	if (i2 < index[1][0] || i2 > index[1][1])
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I2);
+	if (i3 < index[2][0] || i3 > index[2][1])
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I3);
+	if (i4 < index[3][0] || i4 > index[3][1])
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I4);
+	return ((size_t)((ptrdiff_t)i1 - index[0][0]) << shift[0]) | ((size_t)((ptrdiff_t)i2 - index[1][0]) << shift[1])
+		| ((size_t)((ptrdiff_t)i3 - index[2][0]) << shift[2]) | (size_t)((ptrdiff_t)i4 - index[3][0]);
+}
+
+template<typename T>
+inline size_t smatrix4<T>::getSlot(size_t key) const
+{
+	//     2^64 / phi    
+	return slotBits == 0 ? 0 : (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> (64 - slotBits));
+}
+
+template<typename T>
+inline size_t smatrix4<T>::locate(size_t key) const
+{
+	size_t last = slots.size() - 1;
+	for (size_t slot = getSlot(key); slots[slot] != 0; slot = (slot + 1) & last)
+		if (keys[slots[slot] - 1] == key)
+			return slots[slot] - 1;
+	return keys.size();
+}
+
+template<typename T>
+template<typename... Args>
+inline size_t smatrix4<T>::append(size_t key, Args&&... args)
+{
+	if ((keys.size() + 1) * 2 > slots.size())
+		rehash(slotBits + 1);
+	values.emplace_back(std::forward<Args>(args)...);
+	try
+	{
+		keys.push_back(key);
+	}
+	catch (...)
+	{
+		values.pop_back();
+		throw;
+	}
+	size_t position = keys.size() - 1;
+	if (position > 0 && keys[position - 1] > key)
+		sorted = false;
+	size_t last = slots.size() - 1;
+	size_t slot = getSlot(key);
+	while (slots[slot] != 0)
+		slot = (slot + 1) & last;
+	slots[slot] = position + 1;
+	return position;
+}
+
+template<typename T>
+inline void smatrix4<T>::rehash(int bits)
+{
+	slotBits = bits;
+	slots.assign((size_t)1 << bits, 0);
+	size_t last = slots.size() - 1;
+	for (size_t position = 0; position < keys.size(); position++)
+	{
+		size_t slot = getSlot(keys[position]);
+		while (slots[slot] != 0)
+			slot = (slot + 1) & last;
+		slots[slot] = position + 1;
+	}
+}
+
+template<typename T>
+inline void smatrix4<T>::sort()
+{
+	std::vector<size_t> order(keys.size());
+	for (size_t k = 0; k < order.size(); k++)
+		order[k] = k;
+	std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return keys[a] < keys[b]; });
+	std::vector<size_t> sortedKeys(keys.size());
+	std::vector<T> sortedValues;
+	sortedValues.reserve(values.capacity());
+	for (size_t k = 0; k < order.size(); k++)
+	{
+		sortedKeys[k] = keys[order[k]];
+		sortedValues.push_back(std::move(values[order[k]]));
+	}
+	keys.swap(sortedKeys);
+	values.swap(sortedValues);
+	rehash(slotBits);
+	sorted = true;
+}
+
+template<typename T>
+inline size_t smatrix4<T>::checkLength(int lower, int upper, const char* message)
+{
+	if (lower > upper)
+		throw std::invalid_argument(message);
+	return (size_t)((ptrdiff_t)upper - lower) + 1;
+}
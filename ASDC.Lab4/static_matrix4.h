@@ -0,0 +1,255 @@
+#pragma once
+#include "matrix4.h"
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order = ROW_MAJOR>
+/// <summary>
+///      ,       ,      .
+/// </summary>
+/// <remarks>
+///        ,         ,
+///     <see cref="at"/>    .     <c>std::array</c>,  
+///             . ,    ,  <see cref="get"/>,
+///        .   <c>ROW_MAJOR</c>  <c>COLUMN_MAJOR</c>   .
+/// </remarks>
+class static_matrix4
+{
+	static_assert(I1L <= I1H && I2L <= I2H && I3L <= I3H && I4L <= I4H, "       .");
+	static_assert(hasLines(Order), "            .");
+
+	static constexpr ptrdiff_t length1 = (ptrdiff_t)I1H - I1L + 1, length2 = (ptrdiff_t)I2H - I2L + 1, length3 = (ptrdiff_t)I3H - I3L + 1, length4 = (ptrdiff_t)I4H - I4L + 1;
+	static constexpr ptrdiff_t stride1 = Order == ROW_MAJOR ? length2 * length3 * length4 : 1;
+	static constexpr ptrdiff_t stride2 = Order == ROW_MAJOR ? length3 * length4 : length1;
+	static constexpr ptrdiff_t stride3 = Order == ROW_MAJOR ? length4 : length1 * length2;
+	static constexpr ptrdiff_t stride4 = Order == ROW_MAJOR ? 1 : length1 * length2 * length3;
+	static constexpr ptrdiff_t base = I1L * stride1 + I2L * stride2 + I3L * stride3 + I4L * stride4;
+
+	std::array<T, (size_t)(length1 * length2 * length3 * length4)> vector;
+
+public:
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = Order;
+
+	/// <summary>
+	///    <see cref="static_matrix4"/>,     :     .
+	/// </summary>
+	/// <remarks>
+	///  <c>static_matrix4 m{}</c>         .
+	/// </remarks>
+	static_matrix4() = default;
+
+	/// <summary>
+	///    <see cref="static_matrix4"/>,     .
+	/// </summary>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	explicit static_matrix4(ELEMENT_INITIALIZATION initialization);
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='i1'>  ,     .</param>
+	/// <param name='i2'>  ,     .</param>
+	/// <param name='i3'>  ,     .</param>
+	/// <param name='i4'>  ,     .</param>
+	/// <returns>  ,    .</returns>
+	/// <exception cref="std::out_of_range">       <see cref="getLowerBound"/>  <see cref="getUpperBound"/>.</exception>
+	constexpr T& at(int i1, int i2, int i3, int i4);
+
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	constexpr T& operator()(int i1, int i2, int i3, int i4);
+
+	template<int i1, int i2, int i3, int i4>
+	/// <summary>
+	///      ,    ;      .
+	/// </summary>
+	/// <returns>  ,        .</returns>
+	constexpr T& get();
+
+	/// <summary>
+	///           .
+	/// </summary>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>    .</returns>
+	static constexpr size_t getOffset(int i1, int i2, int i3, int i4);
+
+	/// <summary>
+	///         <see cref="static_matrix4"/>.
+	/// </summary>
+	static constexpr size_t getLength();
+
+	/// <summary>
+	///  ,        <see cref="static_matrix4"/>.
+	/// </summary>
+	/// <param name='dimension'> ,     ,     .</param>
+	/// <returns>32-    ,      .</returns>
+	/// <exception cref="std::out_of_range">  <paramref name="dimension"/>  1   4.</exception>
+	static constexpr int getLength(int dimension);
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static constexpr int getAddCount();
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static constexpr int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <returns>32-    ,          .</returns>
+	static constexpr int getIndirectionCount();
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">  <paramref name="dimension"/>  1   4.</exception>
+	static constexpr int getLowerBound(int dimension);
+
+	/// <summary>
+	///        .
+	/// </summary>
+	/// <param name='dimension'> ,     ,      .</param>
+	/// <returns>      .</returns>
+	/// <exception cref="std::out_of_range">  <paramref name="dimension"/>  1   4.</exception>
+	static constexpr int getUpperBound(int dimension);
+
+	template<typename Visitor>
+	/// <summary>
+	///          .
+	/// </summary>
+	/// <param name='visitor'> <c>visitor(T&amp; item, int i1, int i2, int i3, int i4)</c>,    .</param>
+	void forEach(Visitor visitor);
+};
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::static_matrix4(ELEMENT_INITIALIZATION initialization)
+{
+	if (initialization == VALUE_INITIALIZATION)
+		vector.fill(T());
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr T & static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::at(int i1, int i2, int i3, int i4)
+{
+	if (i1 < I1L || i1 > I1H)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I1);
+	if (i2 < I2L || i2 > I2H)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I2);
+	if (i3 < I3L || i3 > I3H)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I3);
+	if (i4 < I4L || i4 > I4H)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_I4);
+	return vector[getOffset(i1, i2, i3, i4)];
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr T & static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::operator()(int i1, int i2, int i3, int i4)
+{
+	return vector[getOffset(i1, i2, i3, i4)];
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+template<int i1, int i2, int i3, int i4>
+inline constexpr T & static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::get()
+{
+	static_assert(i1 >= I1L && i1 <= I1H, MESSAGE_OUT_OF_RANGE_I1);
+	static_assert(i2 >= I2L && i2 <= I2H, MESSAGE_OUT_OF_RANGE_I2);
+	static_assert(i3 >= I3L && i3 <= I3H, MESSAGE_OUT_OF_RANGE_I3);
+	static_assert(i4 >= I4L && i4 <= I4H, MESSAGE_OUT_OF_RANGE_I4);
+	constexpr size_t offset = getOffset(i1, i2, i3, i4);
+	return vector[offset];
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr size_t static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getOffset(int i1, int i2, int i3, int i4)
+{
+	return (size_t)(i1 * stride1 + i2 * stride2 + i3 * stride3 + i4 * stride4 - base);
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr size_t static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getLength()
+{
+	return (size_t)(length1 * length2 * length3 * length4);
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr int static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getLength(int dimension)
+{
+	if (dimension < 1 || dimension > 4)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_DIMENSION);
+	return (int)(dimension == 1 ? length1 : dimension == 2 ? length2 : dimension == 3 ? length3 : length4);
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr int static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getAddCount()
+{
+	return 4;
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr int static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getMulCount()
+{
+	return 3;
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr int static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getIndirectionCount()
+{
+	return 0;
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr int static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getLowerBound(int dimension)
+{
+	if (dimension < 1 || dimension > 4)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_DIMENSION);
+	return dimension == 1 ? I1L : dimension == 2 ? I2L : dimension == 3 ? I3L : I4L;
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+inline constexpr int static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::getUpperBound(int dimension)
+{
+	if (dimension < 1 || dimension > 4)
+		throw std::out_of_range(MESSAGE_OUT_OF_RANGE_DIMENSION);
+	return dimension == 1 ? I1H : dimension == 2 ? I2H : dimension == 3 ? I3H : I4H;
+}
+
+template<typename T, int I1L, int I1H, int I2L, int I2H, int I3L, int I3H, int I4L, int I4H, STORAGE_ORDER Order>
+template<typename Visitor>
+inline void static_matrix4<T, I1L, I1H, I2L, I2H, I3L, I3H, I4L, I4H, Order>::forEach(Visitor visitor)
+{
+	T* item = vector.data();
+	if (Order == ROW_MAJOR)
+	{
+		for (int i1 = I1L; i1 <= I1H; i1++)
+			for (int i2 = I2L; i2 <= I2H; i2++)
+				for (int i3 = I3L; i3 <= I3H; i3++)
+					for (int i4 = I4L; i4 <= I4H; i4++)
+						visitor(*item++, i1, i2, i3, i4);
+	}
+	else
+	{
+		for (int i4 = I4L; i4 <= I4H; i4++)
+			for (int i3 = I3L; i3 <= I3H; i3++)
+				for (int i2 = I2L; i2 <= I2H; i2++)
+					for (int i1 = I1L; i1 <= I1H; i1++)
+						visitor(*item++, i1, i2, i3, i4);
+	}
+}
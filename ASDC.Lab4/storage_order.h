@@ -0,0 +1,24 @@
+#pragma once
+
+/// <summary>
+///        .
+/// </summary>
+/// <remarks>
+///  <c>ROW_MAJOR</c>  <c>COLUMN_MAJOR</c>     (  )    .
+///  <c>Z_ORDER</c>       (<see cref="morton_code"/>),      .
+///  <c>TILED</c>       (<see cref="bmatrix4_tiled_layout"/>), ,     ,
+///   ;       .
+/// </remarks>
+enum STORAGE_ORDER : int
+{
+	ROW_MAJOR, COLUMN_MAJOR, Z_ORDER, TILED
+};
+
+/// <summary>
+///  true,             (<c>ROW_MAJOR</c>  <c>COLUMN_MAJOR</c>).
+/// </summary>
+/// <param name='order'>  .</param>
+constexpr bool hasLines(STORAGE_ORDER order)
+{
+	return order == ROW_MAJOR || order == COLUMN_MAJOR;
+}
\ No newline at end of file
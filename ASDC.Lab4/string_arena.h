@@ -0,0 +1,91 @@
+#pragma once
+
+/// <summary>
+///   <see cref="string_arena"/>    .
+/// </summary>
+#define STRING_ARENA_BLOCK_SIZE 65536
+
+/// <summary>
+///   ,            .
+/// </summary>
+/// <remarks>
+///         ;   ,    ,
+///       .       , 
+/// <see cref="release"/>       ,   ,   .
+/// </remarks>
+class string_arena
+{
+	char* blocks;
+	char* current;
+	size_t available;
+	size_t blockSize;
+
+public:
+	/// <summary>
+	///     <see cref="string_arena"/>.
+	/// </summary>
+	/// <param name='blockSize'>   .</param>
+	string_arena(size_t blockSize = STRING_ARENA_BLOCK_SIZE);
+
+	string_arena(const string_arena&) = delete;
+
+	string_arena& operator=(const string_arena&) = delete;
+
+	/// <summary>
+	///   ,  <see cref="string_arena"/>.
+	/// </summary>
+	~string_arena();
+
+	/// <summary>
+	///            .
+	/// </summary>
+	/// <param name='length'>     .</param>
+	/// <returns>   ;     .</returns>
+	/// <exception cref="std::bad_alloc">    .</exception>
+	char* allocate(size_t length);
+
+	/// <summary>
+	///     .
+	/// </summary>
+	void release();
+};
+
+inline string_arena::string_arena(size_t blockSize) : blocks(nullptr), current(nullptr), available(0), blockSize(blockSize)
+{
+}
+
+inline string_arena::~string_arena()
+{
+	release();
+}
+
+inline char * string_arena::allocate(size_t length)
+{
+	if (length + 1 > available)
+	{
+		size_t size = sizeof(char*) + (length + 1 > blockSize ? length + 1 : blockSize);
+		char* block = new char[size];
+		memcpy(block, &blocks, sizeof(char*));
+		blocks = block;
+		current = block + sizeof(char*);
+		available = size - sizeof(char*);
+	}
+	char* text = current;
+	text[length] = '\0';
+	current += length + 1;
+	available -= length + 1;
+	return text;
+}
+
+inline void string_arena::release()
+{
+	while (blocks != nullptr)
+	{
+		char* next;
+		memcpy(&next, blocks, sizeof(char*));
+		delete[] blocks;
+		blocks = next;
+	}
+	current = nullptr;
+	available = 0;
+}
@@ -0,0 +1,300 @@
+#pragma once
+#include "matrix4_adapter.h"
+#include "morton_code.h"
+
+template<typename T>
+/// <summary>
+///       ,             .
+/// </summary>
+/// <remarks>
+///     <c>pdep</c>,    BMI2 (<see cref="morton_code"/>),    ,
+///           ;        .
+///     (<see cref="morton_code::getCapacity"/>),  <see cref="matrix4::forEach"/> (<see cref="forEachCell"/>)      .
+/// </remarks>
+class zmatrix4_layout : public counted_layout
+{
+	morton_code code;
+	std::unique_ptr<size_t[]> table;
+	const size_t* lookup[4];
+
+public:
+	/// <summary>
+	///     <see cref="zmatrix4_layout"/>    .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	/// <param name='vector'>,     .</param>
+	/// <exception cref="std::bad_alloc">     .</exception>
+	zmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T* vector);
+
+	/// <summary>
+	///         .
+	/// </summary>
+	/// <param name='vector'>,     .</param>
+	/// <param name='i1'>  .</param>
+	/// <param name='i2'>  .</param>
+	/// <param name='i3'>  .</param>
+	/// <param name='i4'>  .</param>
+	/// <returns>  ,    .</returns>
+	T* address(T* vector, int i1, int i2, int i3, int i4) const;
+
+	/// <summary>
+	///       .
+	/// </summary>
+	/// <param name='cell'>  .</param>
+	/// <param name='index'>    1-4.</param>
+	/// <returns>true,     ; false,   .</returns>
+	bool decode(size_t cell, int (&index)[4]) const;
+
+	template<typename Visitor>
+	/// <summary>
+	///         ,        (<see cref="morton_code::forEach"/>).
+	/// </summary>
+	/// <param name='visitor'> <c>visitor(size_t cell, const int (&amp;index)[4])</c>,         1-4.</param>
+	void forEachCell(Visitor visitor) const;
+
+	/// <summary>
+	///             .
+	/// </summary>
+	/// <param name='index'>     .</param>
+	static size_t getCapacity(const std::array<std::array<int, 2>, 4>& index);
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <remarks> BMI2         ,  BMI2      .</remarks>
+	/// <returns>32-    ,        .</returns>
+	int getAddCount() const;
+
+	/// <summary>
+	///  ,        .
+	/// </summary>
+	/// <returns>32-    ,        .</returns>
+	static int getMulCount();
+
+	/// <summary>
+	///  ,          .
+	/// </summary>
+	/// <remarks> BMI2      ,  BMI2        .</remarks>
+	/// <returns>32-    ,          .</returns>
+	int getIndirectionCount() const;
+
+	/// <summary>
+	/// ,       .
+	/// </summary>
+	static const STORAGE_ORDER order = Z_ORDER;
+
+	/// <summary>
+	///   ,     .
+	/// </summary>
+	static const size_t alignment = alignof(T);
+};
+
+template<typename T>
+/// <summary>
+///      ,     ,   .
+/// </summary>
+class zmatrix4 : public matrix4_adapter<T, zmatrix4_layout>
+{
+public:
+	/// <summary>
+	///       <see cref="zmatrix4"/>    .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h);
+
+	/// <summary>
+	///      <see cref="zmatrix4"/>    ,     .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='initialization'>  : <c>VALUE_INITIALIZATION</c>    .</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization);
+
+	/// <summary>
+	///      <see cref="zmatrix4"/>    ,   ,    .
+	/// </summary>	
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='array'>,       .</param>
+	/// <param name="length">    <paramref name="array"/></param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// - -
+	///   <paramref name="array"/>  nullptr.
+	/// - -
+	///   <paramref name="length"/>  .
+	/// </exception>
+	zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T* array, size_t length);
+
+	/// <summary>
+	///    <see cref="zmatrix4"/>,         .
+	/// </summary>
+	/// <remarks>    ,   <c>std::unique_ptr</c>  <c>std::vector</c>  .</remarks>
+	/// <param name='matrix'>,    .</param>
+	zmatrix4(matrix4<T, zmatrix4_layout>&& matrix);
+
+	template<typename Source>
+	/// <summary>
+	///      <see cref="zmatrix4"/>    ,           .
+	/// </summary>
+	/// <param name='i1l'>     .</param>
+	/// <param name='i1h'>     </param>
+	/// <param name='i2l'>     .</param>
+	/// <param name='i2h'>     .</param>
+	/// <param name='i3l'>     .</param>
+	/// <param name='i3h'>     .</param>
+	/// <param name='i4l'>     .</param>
+	/// <param name='i4h'>     .</param>
+	/// <param name='source'> <c>bool source(T* item)</c>,   ; . <see cref="matrix4::matrix4"/>.</param>
+	/// <exception cref="std::invalid_argument">
+	///   <paramref name="i1h"/>  <paramref name="i1l"/>.
+	/// - -
+	///	  <paramref name="i2h"/>  <paramref name="i2l"/>.
+	/// - -
+	///	  <paramref name="i3h"/>  <paramref name="i3l"/>.
+	/// - -
+	///	  <paramref name="i4h"/>  <paramref name="i4l"/>.
+	/// </exception>
+	zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source);
+};
+
+template<typename T>
+inline zmatrix4_layout<T>::zmatrix4_layout(const std::array<std::array<int, 2>, 4>& index, T *) : code(index), lookup{ nullptr, nullptr, nullptr, nullptr }
+{
+	if (code.hasBmi2())
+		return;
+	size_t length[4], total = 0;
+	for (int d = 0; d < 4; d++)
+	{
+		length[d] = (size_t)((ptrdiff_t)index[d][1] - index[d][0]) + 1;
+		total += length[d];
+	}
+	table.reset(new size_t[total]);
+	size_t* item = table.get();
+	for (int d = 0; d < 4; d++)
+	{
+		//     ,    ,      
+		lookup[d] = item - index[d][0];
+		for (size_t j = 0; j < length[d]; j++)
+			*item++ = morton_code::deposit(j, code.getMask(d));
+	}
+}
+
+template<typename T>
+inline T * zmatrix4_layout<T>::address(T * vector, int i1, int i2, int i3, int i4) const
+{
+	if (code.hasBmi2())
+	{
+		MATRIX4_COUNT(counter.record(ADDITION, 7));
+		return vector + code.encode(i1, i2, i3, i4);
+	}
+	MATRIX4_COUNT(counter.record(ADDITION, 3));
+	MATRIX4_COUNT(counter.record(INDIRECTION, 4));
+	return vector + (lookup[0][i1] | lookup[1][i2] | lookup[2][i3] | lookup[3][i4]);
+}
+
+template<typename T>
+inline bool zmatrix4_layout<T>::decode(size_t cell, int (&index)[4]) const
+{
+	return code.decode(cell, index);
+}
+
+template<typename T>
+template<typename Visitor>
+inline void zmatrix4_layout<T>::forEachCell(Visitor visitor) const
+{
+	code.forEach(visitor);
+}
+
+template<typename T>
+inline size_t zmatrix4_layout<T>::getCapacity(const std::array<std::array<int, 2>, 4>& index)
+{
+	return morton_code(index).getCapacity();
+}
+
+template<typename T>
+inline int zmatrix4_layout<T>::getAddCount() const
+{
+	return code.hasBmi2() ? 7 : 3;
+}
+
+template<typename T>
+inline int zmatrix4_layout<T>::getMulCount()
+{
+	return 0;
+}
+
+template<typename T>
+inline int zmatrix4_layout<T>::getIndirectionCount() const
+{
+	return code.hasBmi2() ? 0 : 4;
+}
+
+template<typename T>
+inline zmatrix4<T>::zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h) : matrix4_adapter<T, zmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h)
+{
+}
+
+template<typename T>
+inline zmatrix4<T>::zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, ELEMENT_INITIALIZATION initialization) : matrix4_adapter<T, zmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, initialization)
+{
+}
+
+template<typename T>
+inline zmatrix4<T>::zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, T * array, size_t length) : matrix4_adapter<T, zmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, array, length)
+{
+}
+
+template<typename T>
+inline zmatrix4<T>::zmatrix4(matrix4<T, zmatrix4_layout>&& matrix) : matrix4_adapter<T, zmatrix4_layout>::matrix4_adapter(std::move(matrix))
+{
+}
+
+template<typename T>
+template<typename Source>
+inline zmatrix4<T>::zmatrix4(int i1l, int i1h, int i2l, int i2h, int i3l, int i3h, int i4l, int i4h, Source source) : matrix4_adapter<T, zmatrix4_layout>::matrix4_adapter(i1l, i1h, i2l, i2h, i3l, i3h, i4l, i4h, source)
+{
+}